@@ -1,11 +1,12 @@
 /*
- *  DSC Keybus Reader 1.3 (esp32)
+ *  DSC Keybus Reader 1.4 (esp32)
  *
  *  Decodes and prints data from the Keybus to a serial interface, including reading from serial for the virtual
  *  keypad.  This is primarily to help decode the Keybus protocol - see the Status example to put the interface
  *  to productive use.
  *
  *  Release notes:
+ *    1.4 - Added JSON lines and binary frame output formats for log processing
  *    1.3 - Added DSC Classic series support
  *    1.2 - Handle spurious data while keybus is disconnected
  *          Removed redundant data processing
@@ -50,6 +51,15 @@
 // DSC Classic series: uncomment for PC1500/PC1550 support (requires PC16-OUT configuration per README.md)
 //#define dscClassicSeries
 
+// Output format: uncomment to print one JSON object per Keybus message or length-prefixed binary frames for log
+// processing instead of the decoded messages (PowerSeries only) - see src/dscKeybusPrintJSON.cpp for the formats.
+//#define outputJSON
+//#define outputFrames
+
+#if defined(dscClassicSeries) && (defined(outputJSON) || defined(outputFrames))
+#error JSON and binary frame output formats are available for the PowerSeries only
+#endif
+
 #include <dscKeybusInterface.h>
 
 // Configures the Keybus interface with the specified pins - dscWritePin is optional, leaving it out disables the
@@ -112,14 +122,7 @@ void loop() {
 
     // Prints panel data
     if (dsc.keybusConnected) {
-      printTimestamp();
-      Serial.print(" ");
-      dsc.printPanelBinary();   // Optionally prints without spaces: printPanelBinary(false);
-      Serial.print(" [");
-      dsc.printPanelCommand();  // Prints the panel command as hex
-      Serial.print("] ");
-      dsc.printPanelMessage();  // Prints the decoded message
-      Serial.println();
+      printPanel();
 
       // Prints keypad and module data when valid panel data is printed
       if (dsc.handleModule()) printModule();
@@ -131,14 +134,41 @@ void loop() {
 }
 
 
+// Prints panel data
+void printPanel() {
+  #if defined(outputJSON)
+  dsc.printPanelJSON();
+  Serial.println();
+  #elif defined(outputFrames)
+  dsc.printPanelFrame();
+  #else
+  printTimestamp();
+  Serial.print(" ");
+  dsc.printPanelBinary();   // Optionally prints without spaces: printPanelBinary(false);
+  Serial.print(" [");
+  dsc.printPanelCommand();  // Prints the panel command as hex
+  Serial.print("] ");
+  dsc.printPanelMessage();  // Prints the decoded message
+  Serial.println();
+  #endif
+}
+
+
 // Prints keypad and module data
 void printModule() {
+  #if defined(outputJSON)
+  dsc.printModuleJSON();
+  Serial.println();
+  #elif defined(outputFrames)
+  dsc.printModuleFrame();
+  #else
   printTimestamp();
   Serial.print(" ");
   dsc.printModuleBinary();   // Optionally prints without spaces: printKeybusBinary(false);
   Serial.print(" ");
   dsc.printModuleMessage();  // Prints the decoded message
   Serial.println();
+  #endif
 }
 
 
@@ -123,7 +123,9 @@ void loop() {
         int ntpDay = ntpTime.tm_mday;
         int ntpHour = ntpTime.tm_hour;
         int ntpMinute = ntpTime.tm_min;
-        if (dsc.ready[timePartition - 1] && dsc.setTime(ntpYear, ntpMonth, ntpDay, ntpHour, ntpMinute, accessCode, timePartition)) {
+        // Skips setting the time if the panel time is already within 2 minutes of the NTP time
+        if (!dsc.timeSyncRequired(ntpYear, ntpMonth, ntpDay, ntpHour, ntpMinute)) ntpSynced = true;
+        else if (dsc.ready[timePartition - 1] && dsc.setTime(ntpYear, ntpMonth, ntpDay, ntpHour, ntpMinute, accessCode, timePartition)) {
           ntpSynced = true;
           Serial.println(F("Time synchronizing"));
         }
@@ -5,8 +5,8 @@
  *  input devices for any general purpose, without needing a DSC panel.
  *
  *  PowerSeries keypad features:
- *    - Read keypad key button presses, including fire/aux/panic alarm keys: dsc.key
- *    - Set keypad lights: Ready, Armed, Trouble, Memory, Bypass, Fire, Program, Backlight, Zones 1-8: dsc.lightReady, dsc.lightZone1, etc
+ *    - Read keypad key button presses, including fire/aux/panic alarm keys: dsc.key, partitions 1-8: dsc.keyPartition
+ *    - Set keypad lights: Ready, Armed, Trouble, Memory, Bypass, Fire, Program, Backlight, Zones 1-64: dsc.lightReady, dsc.lightZones[0], etc
  *    - Set keypad beeps, 1-128: dsc.beep(3)
  *    - Set keypad buzzer in seconds, 1-255: dsc.tone(5)
  *    - Set keypad tone pattern with a number of beeps, an optional constant tone, and the interval in seconds between beeps:
@@ -123,7 +123,7 @@ void loop() {
     inputReceived = false;
 
     #if defined(dscKeypad)
-    if (String(input).startsWith("0x")) dsc.panelCommand05[2] = strtoul(input, NULL, 16);
+    if (String(input).startsWith("0x")) dsc.partitionStatus[0] = strtoul(input, NULL, 16);
     else {
       for (byte i = 0; i < strlen(input); i++) {
         switch (input[i]) {
@@ -31,6 +31,7 @@ dscClassicInterface::dscClassicInterface(byte setClockPin, byte setReadPin, byte
   dscWritePin = setWritePin;
   if (dscWritePin != 255) virtualKeypad = true;
   writeReady = false;
+  writeKeyActive = false;
   writePartition = 1;
   pauseStatus = false;
   accessCodeStay = setAccessCode;
@@ -98,7 +99,7 @@ void dscClassicInterface::stop() {
 
   // Resets the panel capture data and counters
   panelBufferLength = 0;
-  for (byte i = 0; i < dscReadSize; i++) {
+  for (byte i = 0; i < dscClassicReadSize; i++) {
     isrPanelData[i] = 0;
     isrPC16Data[i] = 0;
     isrModuleData[i] = 0;
@@ -143,8 +144,8 @@ bool dscClassicInterface::loop() {
     if (!keybusConnected) return true;
   }
 
-  // Writes keys when multiple keys are sent as a char array
-  if (writeKeysPending) writeKeys(writeKeysArray);
+  // Writes keys from the key buffer
+  writeKeys();
 
   // Skips processing if the panel data buffer is empty
   if (panelBufferLength == 0) return false;
@@ -152,7 +153,7 @@ bool dscClassicInterface::loop() {
   // Copies data from the buffer to panelData[]
   static byte panelBufferIndex = 1;
   byte dataIndex = panelBufferIndex - 1;
-  for (byte i = 0; i < dscReadSize; i++) {
+  for (byte i = 0; i < dscClassicReadSize; i++) {
     panelData[i] = panelBuffer[dataIndex][i];
     pc16Data[i] = pc16Buffer[dataIndex][i];
   }
@@ -189,7 +190,7 @@ bool dscClassicInterface::loop() {
   }
 
   // Sets writeReady status
-  if (!writeKeyPending && !writeKeysPending) writeReady = true;
+  if (!writeKeyPending && keyBufferLength == 0) writeReady = true;
   else writeReady = false;
 
   processPanelStatus();
@@ -699,129 +700,212 @@ bool dscClassicInterface::handleModule() {
 }
 
 // Sets up writes for a single key
-void dscClassicInterface::write(const char receivedKey) {
+byte dscClassicInterface::write(const char receivedKey) {
+  char receivedKeys[2] = {receivedKey, '\0'};
+  return bufferKeys(receivedKeys);
+}
 
-  // Blocks if a previous write is in progress
-  while(writeKeyPending || writeKeysPending) {
-    loop();
-    #if defined(ESP8266)
-    yield();
-    #endif
-  }
 
-  if (strlen(accessCodeStay) < 4) {
-    setWriteKey(receivedKey);
-  }
-  else {
-    switch(receivedKey) {
-      case 's':
-      case 'S': write(accessCodeStay); break;
-      case 'w':
-      case 'W': write(accessCodeAway); break;
-      case 'n':
-      case 'N': write(accessCodeNight); break;
-      default: setWriteKey(receivedKey);
+// Sets up writes for multiple keys sent as a char array
+byte dscClassicInterface::write(const char *receivedKeys, bool blockingWrite) {
+  byte keysHandle = bufferKeys(receivedKeys);
+
+  // Optionally blocks until the write is complete
+  if (blockingWrite && keysHandle != 0) {
+    while (!writeComplete(keysHandle)) {
+      loop();
+      #if defined(ESP8266)
+      yield();
+      #endif
     }
   }
+
+  return keysHandle;
 }
 
 
-// Sets up writes for multiple keys sent as a char array
-void dscClassicInterface::write(const char *receivedKeys, bool blockingWrite) {
-
-  // Blocks if a previous write is in progress
-  while(writeKeyPending || writeKeysPending) {
-    loop();
-    #if defined(ESP8266)
-    yield();
-    #endif
+// Copies keys to the key buffer, returns a write handle or 0 if the keys do not fit.  If an access code is set, the
+// arm keys 's', 'w', and 'n' are replaced with the access code sequences.
+byte dscClassicInterface::bufferKeys(const char *receivedKeys) {
+  byte keyCount = 0;
+  for (byte i = 0; receivedKeys[i] != '\0'; i++) {
+    const char *armKeys = accessCodeKeys(receivedKeys[i]);
+    if (armKeys != NULL) keyCount += strlen(armKeys);
+    else keyCount++;
+    if (keyCount > dscClassicKeyBufferSize - keyBufferLength) return 0;
+  }
+
+  writeHandle++;
+  if (writeHandle == 0) writeHandle = 1;
+
+  // Starts the count of written keys for keysWritten()
+  byte ticket = writeHandle % dscClassicWriteTicketSize;
+  writeTicketHandle[ticket] = writeHandle;
+  writeTicketKeys[ticket] = 0;
+
+  for (byte i = 0; receivedKeys[i] != '\0'; i++) {
+    const char *armKeys = accessCodeKeys(receivedKeys[i]);
+    byte armKeyIndex = 0;
+    char receivedKey = receivedKeys[i];
+    if (armKeys != NULL) receivedKey = armKeys[0];
+
+    while (receivedKey != '\0') {
+      byte keyPosition = keyBufferIndex + keyBufferLength;
+      if (keyPosition >= dscClassicKeyBufferSize) keyPosition -= dscClassicKeyBufferSize;
+      keyBuffer[keyPosition] = receivedKey;
+      keyBufferHandle[keyPosition] = writeHandle;
+      keyBufferLength++;
+
+      if (armKeys == NULL) break;
+      armKeyIndex++;
+      receivedKey = armKeys[armKeyIndex];
+    }
   }
 
-  if (strlen(receivedKeys) == 1) {
-    write(receivedKeys[0]);
-    return;
+  if (keyBufferLength > 0) {
+    writeReady = false;
+    writeKeys();
   }
+  return writeHandle;
+}
 
-  writeKeysArray = receivedKeys;
 
-  if (writeKeysArray[0] != '\0') {
-    writeKeysPending = true;
-    writeReady = false;
+// Returns the access code sequence for arm keys if an access code is set
+const char * dscClassicInterface::accessCodeKeys(const char receivedKey) {
+  if (strlen(accessCodeStay) < 4) return NULL;
+  switch (receivedKey) {
+    case 's':
+    case 'S': return accessCodeStay;
+    case 'w':
+    case 'W': return accessCodeAway;
+    case 'n':
+    case 'N': return accessCodeNight;
+    default: return NULL;
   }
+}
 
-  // Optionally blocks until the write is complete, necessary if the received keys char array is ephemeral
-  if (blockingWrite) {
-    while (writeKeysPending) {
-      writeKeys(writeKeysArray);
-      loop();
-      #if defined(ESP8266)
-      yield();
-      #endif
-    }
+
+// Checks if all keys from a write handle have been written
+bool dscClassicInterface::writeComplete(byte checkedHandle) {
+  if (checkedHandle == 0) return false;
+  if (writeKeyPending && writeKeyHandle == checkedHandle) return false;
+
+  byte keyPosition = keyBufferIndex;
+  for (byte i = 0; i < keyBufferLength; i++) {
+    if (keyBuffer[keyPosition] != 0 && keyBufferHandle[keyPosition] == checkedHandle) return false;
+    keyPosition++;
+    if (keyPosition >= dscClassicKeyBufferSize) keyPosition = 0;
   }
-  else writeKeys(writeKeysArray);
+  return true;
 }
 
 
-// Writes multiple keys from a char array
-void dscClassicInterface::writeKeys(const char *writeKeysArray) {
-  static byte writeCounter = 0;
+// Returns the number of keys from a write handle that dscClockInterrupt() has written to the Keybus
+byte dscClassicInterface::keysWritten(byte checkedHandle) {
+  countWrittenKey();
 
-  if (!writeKeyPending && writeKeysPending && writeCounter < strlen(writeKeysArray)) {
-    if (writeKeysArray[writeCounter] != '\0') {
-      setWriteKey(writeKeysArray[writeCounter]);
-      writeCounter++;
-      if (writeKeysArray[writeCounter] == '\0') {
-        writeKeysPending = false;
-        writeCounter = 0;
-      }
-    }
+  byte ticket = checkedHandle % dscClassicWriteTicketSize;
+  if (checkedHandle == 0 || writeTicketHandle[ticket] != checkedHandle) return 0;
+  return writeTicketKeys[ticket];
+}
+
+
+// Counts the key set by setWriteKey() once dscClockInterrupt() has written it
+void dscClassicInterface::countWrittenKey() {
+  if (!writeKeyActive || writeKeyPending) return;
+  writeKeyActive = false;
+
+  byte ticket = writeKeyHandle % dscClassicWriteTicketSize;
+  if (writeTicketHandle[ticket] == writeKeyHandle) writeTicketKeys[ticket]++;
+}
+
+
+// Sets the next key from the key buffer for dscClockInterrupt() once the previous key is written, called by loop()
+// and write().  Alarm keys are set ahead of other keys in the key buffer.
+void dscClassicInterface::writeKeys() {
+  countWrittenKey();
+
+  // Removes written keys from the start of the key buffer
+  while (keyBufferLength > 0 && keyBuffer[keyBufferIndex] == 0) {
+    keyBufferIndex++;
+    if (keyBufferIndex >= dscClassicKeyBufferSize) keyBufferIndex = 0;
+    keyBufferLength--;
+  }
+  if (writeKeyPending || keyBufferLength == 0) return;
+
+  byte keyPosition = keyBufferIndex;
+  for (byte i = 0; i < keyBufferLength; i++) {
+    if (writeAlarmKey(keyBuffer[keyPosition])) break;
+    keyPosition++;
+    if (keyPosition >= dscClassicKeyBufferSize) keyPosition = 0;
   }
+  if (!writeAlarmKey(keyBuffer[keyPosition])) keyPosition = keyBufferIndex;
+
+  if (setWriteKey(keyBuffer[keyPosition], keyBufferHandle[keyPosition])) keyBuffer[keyPosition] = 0;  // Marks the key as written
 }
 
 
-// Specifies the key value to be written by dscClockInterrupt() and selects the write partition.  This includes a 500ms
-// delay after alarm keys to resolve errors when additional keys are sent immediately after alarm keys.
-void dscClassicInterface::setWriteKey(const char receivedKey) {
-  static unsigned long previousTime;
+// Checks for keypad fire, auxiliary, and panic alarm keys
+bool dscClassicInterface::writeAlarmKey(const char receivedKey) {
+  switch (receivedKey) {
+    case 'F':
+    case 'f':
+    case 'A':
+    case 'a':
+    case 'P':
+    case 'p': return true;
+    default: return false;
+  }
+}
 
 
-  // Sets the binary to write for virtual keypad keys
-  if (!writeKeyPending && (millis() - previousTime > 500 || millis() <= 500)) {
-    bool validKey = true;
-
-    // Sets binary for virtual keypad keys
-    switch (receivedKey) {
-      case '0': writeKey = 0xD7; break;
-      case '1': writeKey = 0xBE; break;
-      case '2': writeKey = 0xDE; break;
-      case '3': writeKey = 0xEE; break;
-      case '4': writeKey = 0xBD; break;
-      case '5': writeKey = 0xDD; break;
-      case '6': writeKey = 0xED; break;
-      case '7': writeKey = 0xBB; break;
-      case '8': writeKey = 0xDB; break;
-      case '9': writeKey = 0xEB; break;
-      case '*': writeKey = 0xB7; break;
-      case '#': writeKey = 0xE7; break;
-      case 'F':
-      case 'f': writeKey = 0x3F; writeAlarm = true; break;                    // Keypad fire alarm
-      case 'A':
-      case 'a': writeKey = 0x5F; writeAlarm = true; break;                    // Keypad auxiliary alarm
-      case 'P':
-      case 'p': writeKey = 0x6F; writeAlarm = true; break;                    // Keypad panic alarm
-      default: {
-        validKey = false;
-        break;
-      }
-    }
+// Specifies the key value to be written by dscClockInterrupt() and selects the write partition.  Keys after alarm keys
+// wait until the panel acknowledges the alarm key with a keypad beep or the keypad alarm bit on the PC16 line to
+// resolve errors when additional keys are sent immediately after alarm keys, with a 500ms delay if neither is seen.
+//
+// Returns false if the key cannot be set yet and should be retried.
+bool dscClassicInterface::setWriteKey(const char receivedKey, byte keyHandle) {
+  static unsigned long previousTime;
 
-    if (writeAlarm) previousTime = millis();  // Sets a marker to time writes after keypad alarm keys
-    if (validKey) {
-      writeKeyPending = true;                 // Sets a flag indicating that a write is pending, cleared by dscClockInterrupt()
-      writeReady = false;
+  if (writeKeyPending || (writeAlarm && millis() - previousTime <= 500 && millis() > 500)) return false;
+
+  bool validKey = true;
+  writeAlarm = false;
+
+  // Sets binary for virtual keypad keys
+  switch (receivedKey) {
+    case '0': writeKey = 0xD7; break;
+    case '1': writeKey = 0xBE; break;
+    case '2': writeKey = 0xDE; break;
+    case '3': writeKey = 0xEE; break;
+    case '4': writeKey = 0xBD; break;
+    case '5': writeKey = 0xDD; break;
+    case '6': writeKey = 0xED; break;
+    case '7': writeKey = 0xBB; break;
+    case '8': writeKey = 0xDB; break;
+    case '9': writeKey = 0xEB; break;
+    case '*': writeKey = 0xB7; break;
+    case '#': writeKey = 0xE7; break;
+    case 'F':
+    case 'f': writeKey = 0x3F; writeAlarmBit = 1; writeAlarm = true; break;  // Keypad fire alarm
+    case 'A':
+    case 'a': writeKey = 0x5F; writeAlarmBit = 2; writeAlarm = true; break;  // Keypad auxiliary alarm
+    case 'P':
+    case 'p': writeKey = 0x6F; writeAlarmBit = 3; writeAlarm = true; break;  // Keypad panic alarm
+    default: {
+      validKey = false;
+      break;
     }
   }
+
+  if (writeAlarm) previousTime = millis();  // Sets a marker to time writes after keypad alarm keys
+  if (validKey) {
+    writeKeyHandle = keyHandle;
+    writeKeyActive = true;
+    writeKeyPending = true;                 // Sets a flag indicating that a write is pending, cleared by dscClockInterrupt()
+    writeReady = false;
+  }
+  return true;
 }
 
 
@@ -1007,7 +1091,7 @@ bool IRAM_ATTR dscClassicInterface::redundantPanelData(byte previousCmd[], volat
   }
   if (redundantData) return true;
   else {
-    for (byte i = 0; i < dscReadSize; i++) previousCmd[i] = currentCmd[i];
+    for (byte i = 0; i < dscClassicReadSize; i++) previousCmd[i] = currentCmd[i];
     return false;
   }
 }
@@ -1051,29 +1135,28 @@ void IRAM_ATTR dscClassicInterface::dscClockInterrupt() {
   else {
     clockHighTime = micros() - previousClockHighTime;  // Tracks the clock high time to find the reset between commands
 
-    // Virtual keypad
+    // Virtual keypad - keypads send keys in bits 0-7 of a command, so a key starts as the clock falls after the reset
+    // between commands.  The command after each key is left without a key so the panel reads repeated keys as
+    // separate key presses, making the second command after a key the earliest slot for the next key.
     if (virtualKeypad) {
       static bool writeStart = false;
+      static bool writeRelease = false;
 
-      if (writeKeyPending && millis() - writeCompleteTime > 50) {
-        writeKeyWait = false;
-      }
-
-      // Writes a regular key
-      if (writeKeyPending && !writeKeyWait) {
-
-        if (clockHighTime > 2000) {
+      if (clockHighTime > 2000) {
+        if (writeRelease) writeRelease = false;
+        else if (writeKeyPending) {
           if (!((writeKey >> 7) & 0x01)) digitalWrite(dscWritePin, HIGH);
           writeStart = true;
+          writeKeyWait = false;
         }
-        else if (writeStart && isrPanelBitTotal <= 7) {
-          if (!((writeKey >> (7 - isrPanelBitCount)) & 0x01)) digitalWrite(dscWritePin, HIGH);
-          if (isrPanelBitTotal == 7) {
-            writeKeyPending = false;
-            writeKeyWait = true;
-            writeCompleteTime = millis();
-            writeStart = false;
-          }
+      }
+      else if (writeStart && isrPanelBitTotal <= 7) {
+        if (!((writeKey >> (7 - isrPanelBitCount)) & 0x01)) digitalWrite(dscWritePin, HIGH);
+        if (isrPanelBitTotal == 7) {
+          writeKeyPending = false;
+          if (writeAlarm) writeKeyWait = true;  // Waits for the panel to acknowledge the alarm key in dscDataInterrupt()
+          writeRelease = true;
+          writeStart = false;
         }
       }
     }
@@ -1100,8 +1183,8 @@ void IRAM_ATTR dscClassicInterface::dscDataInterrupt() {
   // Panel sends data while the clock is high
   if (digitalRead(dscClockPin) == HIGH) {
 
-    // Stops processing Keybus data at the dscReadSize limit
-    if (isrPanelByteCount >= dscReadSize) skipData = true;
+    // Stops processing Keybus data at the dscClassicReadSize limit
+    if (isrPanelByteCount >= dscClassicReadSize) skipData = true;
 
     else {
       if (isrPanelBitCount < 8) {
@@ -1134,11 +1217,35 @@ void IRAM_ATTR dscClassicInterface::dscDataInterrupt() {
     if (clockHighTime > 2000) {
       keybusTime = millis();
 
+      // Checks for the panel acknowledgement of a virtual keypad alarm key to end the alarm key delay early: a new
+      // keypad beep in the panel data or the keypad alarm bit for the key in the PC16 data.  The beep bit stays set
+      // while the panel is beeping for exit delay, trouble, or chime and the alarm bits stay set during an alarm, so
+      // only a change from the previous frame acknowledges the key.
+      if (virtualKeypad && isrPanelBitTotal >= 16) {
+        static bool writeAckFrame = false;
+        static bool previousBeep = false;
+        static bool previousAlarmBit = false;
+        bool beep = bitRead(isrPanelData[1], 0);
+        bool alarmBit = bitRead(isrPC16Data[1], writeAlarmBit);
+
+        if (writeKeyWait) {
+          if (writeAckFrame && ((beep && !previousBeep) || (alarmBit && !previousAlarmBit))) {
+            writeKeyWait = false;
+            if (!writeKeyPending) writeAlarm = false;
+          }
+          writeAckFrame = true;  // Skips the panel data sent while the key was written
+        }
+        else writeAckFrame = false;
+
+        previousBeep = beep;
+        previousAlarmBit = alarmBit;
+      }
+
       // Skips incomplete data and redundant data
       if (isrPanelBitTotal < 8) skipData = true;
       else {
-        static byte previousPanelData[dscReadSize];
-        static byte previousPC16Data[dscReadSize];
+        static byte previousPanelData[dscClassicReadSize];
+        static byte previousPC16Data[dscClassicReadSize];
 
         if (lightBlink && readyLight) skipData = false;
         else if (redundantPanelData(previousPanelData, isrPanelData, isrPanelByteCount) &&
@@ -1148,9 +1255,9 @@ void IRAM_ATTR dscClassicInterface::dscDataInterrupt() {
       }
 
       // Stores new panel data in the panel buffer
-      if (panelBufferLength == dscBufferSize) bufferOverflow = true;
-      else if (!skipData && panelBufferLength < dscBufferSize) {
-        for (byte i = 0; i < dscReadSize; i++) {
+      if (panelBufferLength == dscClassicBufferSize) bufferOverflow = true;
+      else if (!skipData && panelBufferLength < dscClassicBufferSize) {
+        for (byte i = 0; i < dscClassicReadSize; i++) {
           panelBuffer[panelBufferLength][i] = isrPanelData[i];
           pc16Buffer[panelBufferLength][i] = isrPC16Data[i];
         }
@@ -1164,20 +1271,20 @@ void IRAM_ATTR dscClassicInterface::dscDataInterrupt() {
         if (moduleDataDetected) {
           moduleDataDetected = false;
           moduleDataCaptured = true;  // Sets a flag for handleModule()
-          for (byte i = 0; i < dscReadSize; i++) moduleData[i] = isrModuleData[i];
+          for (byte i = 0; i < dscClassicReadSize; i++) moduleData[i] = isrModuleData[i];
           moduleBitCount = isrModuleBitTotal;
           moduleByteCount = isrModuleByteCount;
         }
 
         // Resets the keypad and module capture data and counters
-        for (byte i = 0; i < dscReadSize; i++) isrModuleData[i] = 0;
+        for (byte i = 0; i < dscClassicReadSize; i++) isrModuleData[i] = 0;
         isrModuleBitTotal = 0;
         isrModuleBitCount = 0;
         isrModuleByteCount = 0;
       }
 
       // Resets the panel capture data and counters
-      for (byte i = 0; i < dscReadSize; i++) {
+      for (byte i = 0; i < dscClassicReadSize; i++) {
         isrPanelData[i] = 0;
         isrPC16Data[i] = 0;
       }
@@ -1188,7 +1295,7 @@ void IRAM_ATTR dscClassicInterface::dscDataInterrupt() {
     }
 
     // Keypad and module data is not buffered and skipped if the panel data buffer is filling
-    if (processModuleData && isrModuleByteCount < dscReadSize && panelBufferLength <= 1) {
+    if (processModuleData && isrModuleByteCount < dscClassicReadSize && panelBufferLength <= 1) {
 
       // Data is captured in each byte by shifting left by 1 bit and writing to bit 0
       if (isrModuleBitCount < 8) {
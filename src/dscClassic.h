@@ -22,16 +22,31 @@
 
 #include <Arduino.h>
 
-const byte dscPartitions = 1;   // Maximum number of partitions - requires 19 bytes of memory per partition
-const byte dscZones = 1;        // Maximum number of zone groups, 8 zones per group - requires 6 bytes of memory per zone group
-const byte dscReadSize = 2;     // Maximum bytes of a Keybus command
+const byte dscClassicPartitions = 1;  // Maximum number of partitions - requires 19 bytes of memory per partition
+const byte dscClassicZones = 1;       // Maximum number of zone groups, 8 zones per group - requires 6 bytes of memory per zone group
+const byte dscClassicReadSize = 2;    // Maximum bytes of a Keybus command
 
 #if defined(__AVR__)
-const byte dscBufferSize = 10;  // Number of commands to buffer if the sketch is busy - requires dscReadSize + 2 bytes of memory per command
+const byte dscClassicBufferSize = 10;      // Number of commands to buffer if the sketch is busy - requires dscClassicReadSize + 2 bytes of memory per command
+const byte dscClassicKeyBufferSize = 24;   // Number of keys to buffer for virtual keypad writes - requires 2 bytes of memory per key
+const byte dscClassicWriteTicketSize = 4;  // Number of recent writes tracked by keysWritten() - requires 2 bytes of memory per write
 #elif defined(ESP8266)
-const byte dscBufferSize = 50;
+const byte dscClassicBufferSize = 50;
+const byte dscClassicKeyBufferSize = 64;
+const byte dscClassicWriteTicketSize = 16;
 #elif defined(ESP32)
-const DRAM_ATTR byte dscBufferSize = 50;
+const DRAM_ATTR byte dscClassicBufferSize = 50;
+const byte dscClassicKeyBufferSize = 64;
+const byte dscClassicWriteTicketSize = 16;
+#endif
+
+// Sketches built only for the Classic series use the common names - with dscAutoSeries, these are set by dscKeybus.h
+#if !defined dscAutoSeries
+const byte dscPartitions = dscClassicPartitions;
+const byte dscZones = dscClassicZones;
+const byte dscReadSize = dscClassicReadSize;
+const byte dscBufferSize = dscClassicBufferSize;
+const byte dscKeyBufferSize = dscClassicKeyBufferSize;
 #endif
 
 // Exit delay target states
@@ -53,21 +68,20 @@ class dscClassicInterface {
     void stop();                                      // Disables the clock hardware interrupt and data timer interrupt
     void resetStatus();                               // Resets the state of all status components as changed for sketches to get the current status
 
-    // Writes a single key - nonblocking unless a previous write is in progress
-    void write(const char receivedKey);
+    // Writes a single key - nonblocking, returns a write handle or 0 if the key buffer is full
+    byte write(const char receivedKey);
 
-    // Writes multiple keys from a char array
-    //
-    // By default, this is nonblocking unless there is a previous write in progress - in this case, the sketch must keep the char
-    // array defined at least until the write is complete.
+    // Writes multiple keys from a char array - nonblocking, returns a write handle or 0 if the key buffer is full
     //
-    // If the char array is ephemeral, check if the write is complete by checking writeReady or set blockingWrite to true to
-    // block until the write is complete.
-    void write(const char * receivedKeys, bool blockingWrite = false);
+    // Keys are copied to the key buffer and written by loop(), so the char array can be ephemeral.  Check if the write
+    // is complete with writeComplete() or set blockingWrite to true to block until the write is complete.
+    byte write(const char * receivedKeys, bool blockingWrite = false);
+    bool writeComplete(byte writeHandle);             // True if all keys from the write handle have been written
+    byte keysWritten(byte writeHandle);               // Number of keys from the write handle written so far, for the last dscClassicWriteTicketSize writes
 
     // Write control
     static byte writePartition;                       // Set to a partition number for virtual keypad
-    bool writeReady;                                  // True if the library is ready to write a key
+    bool writeReady;                                  // True if the key buffer is empty and no write is in progress
 
     // Prints output to the stream interface set in begin()
     void printPanelBinary(bool printSpaces = true);   // Includes spaces between bytes by default
@@ -86,17 +100,17 @@ class dscClassicInterface {
     bool keybusConnected, keybusChanged;  // True if data is detected on the Keybus
     bool trouble, troubleChanged;
     bool keypadFireAlarm, keypadAuxAlarm, keypadPanicAlarm;
-    bool ready[dscPartitions], readyChanged[dscPartitions];
-    bool armed[dscPartitions], armedAway[dscPartitions], armedStay[dscPartitions];
-    bool noEntryDelay[dscPartitions], armedChanged[dscPartitions];
-    bool alarm[dscPartitions], alarmChanged[dscPartitions];
-    bool exitDelay[dscPartitions], exitDelayChanged[dscPartitions];
-    byte exitState[dscPartitions], exitStateChanged[dscPartitions];
-    bool fire[dscPartitions], fireChanged[dscPartitions];
+    bool ready[dscClassicPartitions], readyChanged[dscClassicPartitions];
+    bool armed[dscClassicPartitions], armedAway[dscClassicPartitions], armedStay[dscClassicPartitions];
+    bool noEntryDelay[dscClassicPartitions], armedChanged[dscClassicPartitions];
+    bool alarm[dscClassicPartitions], alarmChanged[dscClassicPartitions];
+    bool exitDelay[dscClassicPartitions], exitDelayChanged[dscClassicPartitions];
+    byte exitState[dscClassicPartitions], exitStateChanged[dscClassicPartitions];
+    bool fire[dscClassicPartitions], fireChanged[dscClassicPartitions];
     bool openZonesStatusChanged;
-    byte openZones[dscZones], openZonesChanged[dscZones];    // Zone status is stored in an array using 1 bit per zone, up to 64 zones
+    byte openZones[dscClassicZones], openZonesChanged[dscClassicZones];    // Zone status is stored in an array using 1 bit per zone, up to 64 zones
     bool alarmZonesStatusChanged;
-    byte alarmZones[dscZones], alarmZonesChanged[dscZones];  // Zone alarm status is stored in an array using 1 bit per zone, up to 64 zones
+    byte alarmZones[dscClassicZones], alarmZonesChanged[dscClassicZones];  // Zone alarm status is stored in an array using 1 bit per zone, up to 64 zones
     bool pgmOutputsStatusChanged;
     byte pgmOutputs[1], pgmOutputsChanged[1];
     bool armedLight, memoryLight, bypassLight, troubleLight, programLight, fireLight, beep;
@@ -112,34 +126,34 @@ class dscClassicInterface {
      *    00000101 0 10000001 00000001 10010001 11000111 [0x05] Partition 1: Ready Backlight - Partition ready | Partition 2: disabled
      *             ^ Byte 1 (stop bit)
      */
-    static byte panelData[dscReadSize];
-    static byte pc16Data[dscReadSize];
-    static volatile byte moduleData[dscReadSize];
+    static byte panelData[dscClassicReadSize];
+    static byte pc16Data[dscClassicReadSize];
+    static volatile byte moduleData[dscClassicReadSize];
 
     // status[] and lights[] store the current status message and LED state.  These can be accessed directly in the
     // sketch to get data that is not already tracked in the library.  See printPanelMessages() and
     // printPanelLights() in dscClassic.cpp to see how this data translates to the status message and LED status.
-    byte status[dscPartitions];
-    byte lights[dscPartitions];
+    byte status[dscClassicPartitions];
+    byte lights[dscClassicPartitions];
 
     // Process keypad and module data, returns true if data is available
     bool handleModule();
 
-    // True if dscBufferSize needs to be increased
+    // True if dscClassicBufferSize needs to be increased
     static volatile bool bufferOverflow;
 
     // Timer interrupt function to capture data - declared as public for use by AVR Timer2
     static void dscDataInterrupt();
 
     // Sketch cross-compatibility - these elements are not currently used for the Classic series
-    byte accessCode[dscPartitions];
-    bool accessCodeChanged[dscPartitions];
+    byte accessCode[dscClassicPartitions];
+    bool accessCodeChanged[dscClassicPartitions];
     bool accessCodePrompt;
     bool decimalInput;
     bool powerTrouble, powerChanged;
     bool batteryTrouble, batteryChanged;
-    bool disabled[dscPartitions], disabledChanged[dscPartitions];
-    bool entryDelay[dscPartitions], entryDelayChanged[dscPartitions];
+    bool disabled[dscClassicPartitions], disabledChanged[dscClassicPartitions];
+    bool entryDelay[dscClassicPartitions], entryDelayChanged[dscClassicPartitions];
     byte panelVersion;
     bool displayTrailingBits;
     bool timestampChanged;
@@ -155,10 +169,14 @@ class dscClassicInterface {
     void processArmedStatus(bool status);
     void processAlarmStatus(bool status);
     void processExitDelayStatus(bool status);
-    void writeKeys(const char * writeKeysArray);
-    void setWriteKey(const char receivedKey);
+    byte bufferKeys(const char * receivedKeys);
+    const char * accessCodeKeys(const char receivedKey);
+    void writeKeys();
+    void countWrittenKey();
+    bool writeAlarmKey(const char receivedKey);
+    bool setWriteKey(const char receivedKey, byte keyHandle);
     static void dscClockInterrupt();
-    static bool redundantPanelData(byte previousCmd[], volatile byte currentCmd[], byte checkedBytes = dscReadSize);
+    static bool redundantPanelData(byte previousCmd[], volatile byte currentCmd[], byte checkedBytes = dscClassicReadSize);
 
     #if defined(ESP32)
     static hw_timer_t * timer1;
@@ -166,11 +184,15 @@ class dscClassicInterface {
     #endif
 
     Stream* stream;
-    const char * writeKeysArray;
     const char * accessCodeStay;
     char accessCodeAway[7];
     char accessCodeNight[7];
-    bool writeKeysPending;
+    char keyBuffer[dscClassicKeyBufferSize];
+    byte keyBufferHandle[dscClassicKeyBufferSize];
+    byte keyBufferIndex, keyBufferLength;
+    byte writeHandle, writeKeyHandle;
+    bool writeKeyActive;
+    byte writeTicketHandle[dscClassicWriteTicketSize], writeTicketKeys[dscClassicWriteTicketSize];
     bool writeArm;
     bool previousTrouble;
     bool previousKeybus;
@@ -197,15 +219,16 @@ class dscClassicInterface {
     static byte panelBitCount, panelByteCount;
     static volatile bool writeKeyPending, writeKeyWait;
     static volatile bool writeAlarm, starKeyDetected, starKeyCheck, starKeyWait;
+    static volatile byte writeAlarmBit;
     static volatile bool moduleDataCaptured;
-    static volatile unsigned long clockHighTime, keybusTime, writeCompleteTime;
+    static volatile unsigned long clockHighTime, keybusTime;
     static volatile byte panelBufferLength;
-    static volatile byte panelBuffer[dscBufferSize][dscReadSize], pc16Buffer[dscBufferSize][dscReadSize];
-    static volatile byte panelBufferBitCount[dscBufferSize], panelBufferByteCount[dscBufferSize];
+    static volatile byte panelBuffer[dscClassicBufferSize][dscClassicReadSize], pc16Buffer[dscClassicBufferSize][dscClassicReadSize];
+    static volatile byte panelBufferBitCount[dscClassicBufferSize], panelBufferByteCount[dscClassicBufferSize];
     static volatile byte moduleBitCount, moduleByteCount;
     static volatile byte moduleCmd;
-    static volatile byte isrPanelData[dscReadSize], isrPC16Data[dscReadSize], isrPanelBitTotal, isrPanelBitCount, isrPanelByteCount;
-    static volatile byte isrModuleData[dscReadSize], isrModuleBitTotal, isrModuleBitCount, isrModuleByteCount;
+    static volatile byte isrPanelData[dscClassicReadSize], isrPC16Data[dscClassicReadSize], isrPanelBitTotal, isrPanelBitCount, isrPanelByteCount;
+    static volatile byte isrModuleData[dscClassicReadSize], isrModuleBitTotal, isrModuleBitCount, isrModuleByteCount;
 };
 
 #endif // dscClassic_h
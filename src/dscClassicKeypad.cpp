@@ -31,6 +31,8 @@ dscClassicKeypadInterface::dscClassicKeypadInterface(byte setClockPin, byte setR
   dscWritePin = setWritePin;
   commandReady = true;
   keyData = 0xFF;
+  previousKey = 0xFF;
+  keyReleased = true;
   clockInterval = 50000;  // Sets AVR timer 1 to trigger an overflow interrupt every ~1ms to generate a 500Hz clock signal
   keyInterval = 150;
   alarmKeyInterval = 1000;
@@ -152,23 +154,22 @@ bool dscClassicKeypadInterface::loop() {
   // Skips key processing if the key buffer is empty
   if (keyBufferLength == 0) return false;
 
-  // Copies data from the buffer to keyData
-  static byte keyBufferIndex = 1;
-  byte dataIndex = keyBufferIndex - 1;
+  // Copies the oldest key from the buffer to keyData
+  byte dataIndex = keyBufferIndex;
   keyData = keyBuffer[dataIndex];
-  keyBufferIndex++;
+  keyTime = keyBufferTime[dataIndex];
+  keyRepeat = keyBufferRepeat[dataIndex];
 
-  // Resets counters when the buffer is cleared
+  // Removes the key from the buffer
   #if defined(ESP32)
   portENTER_CRITICAL(&timer1Mux);
   #else
   noInterrupts();
   #endif
 
-  if (keyBufferIndex > keyBufferLength) {
-    keyBufferIndex = 1;
-    keyBufferLength = 0;
-  }
+  keyBufferIndex++;
+  if (keyBufferIndex >= dscBufferSize) keyBufferIndex = 0;
+  keyBufferLength--;
 
   #if defined(ESP32)
   portEXIT_CRITICAL(&timer1Mux);
@@ -248,6 +249,35 @@ void dscClassicKeypadInterface::buzzer(byte seconds) {
 }
 
 
+// Stores a key in the key buffer with the time it was pressed and the number of times it repeated while held
+#if defined(__AVR__)
+void dscClassicKeypadInterface::bufferKey(byte keyValue) {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscClassicKeypadInterface::bufferKey(byte keyValue) {
+#elif defined(ESP32)
+void IRAM_ATTR dscClassicKeypadInterface::bufferKey(byte keyValue) {
+#endif
+  if (keyValue == previousKey && !keyReleased) {
+    if (keyRepeatCount < 255) keyRepeatCount++;
+  }
+  else keyRepeatCount = 0;
+  previousKey = keyValue;
+  keyReleased = false;
+
+  if (keyBufferLength == dscBufferSize) {
+    bufferOverflow = true;
+    return;
+  }
+
+  byte keyIndex = keyBufferIndex + keyBufferLength;
+  if (keyIndex >= dscBufferSize) keyIndex -= dscBufferSize;
+  keyBuffer[keyIndex] = keyValue;
+  keyBufferTime[keyIndex] = millis();
+  keyBufferRepeat[keyIndex] = keyRepeatCount;
+  keyBufferLength++;
+}
+
+
 #if defined(__AVR__)
 void dscClassicKeypadInterface::dscClockInterrupt() {
 #elif defined(ESP8266)
@@ -334,14 +364,9 @@ void IRAM_ATTR dscClassicKeypadInterface::dscClockInterrupt() {
             alarmKeyTime = millis();
           }
           else if (millis() - alarmKeyTime > alarmKeyInterval) {
-            keyBuffer[keyBufferLength] = isrModuleData[0];
-            keyBufferLength++;
+            bufferKey(isrModuleData[0]);
             alarmKeyDetected = false;
           }
-          else {
-            keyBuffer[keyBufferLength] = 0xFF;
-            keyBufferLength++;
-          }
         }
 
         // Checks for regular keys and debounces for keyInterval
@@ -349,17 +374,15 @@ void IRAM_ATTR dscClassicKeypadInterface::dscClockInterrupt() {
           alarmKeyDetected = false;
           alarmKeyTime = millis();
 
-          // Skips the debounce interval if a different key is pressed
-          if (keyBuffer[keyBufferLength] != isrModuleData[0]) {
-            keyBuffer[keyBufferLength] = isrModuleData[0];
-            keyBufferLength++;
+          // Skips the debounce interval if a key is newly pressed or a different key is pressed
+          if (keyReleased || previousKey != isrModuleData[0]) {
+            bufferKey(isrModuleData[0]);
             repeatInterval = millis();
           }
 
           // Sets the key
           else if (millis() - repeatInterval > keyInterval) {
-            keyBuffer[keyBufferLength] = isrModuleData[0];
-            keyBufferLength++;
+            bufferKey(isrModuleData[0]);
             repeatInterval = millis();
           }
         }
@@ -368,6 +391,7 @@ void IRAM_ATTR dscClassicKeypadInterface::dscClockInterrupt() {
     else {
       alarmKeyDetected = false;
       alarmKeyTime = millis();
+      keyReleased = true;
     }
 
     // Resets counters
@@ -46,6 +46,10 @@ class dscClassicKeypadInterface {
     // Keypad key
     byte key, keyAvailable;
 
+    // Time in milliseconds when the key was pressed, and the number of times the key repeated while held
+    unsigned long keyTime;
+    byte keyRepeat;
+
     // Keypad lights
     Light lightReady = on, lightArmed, lightMemory, lightBypass, lightTrouble, lightProgram, lightFire, lightBacklight = on;
     Light lightZone1, lightZone2, lightZone3, lightZone4, lightZone5, lightZone6, lightZone7, lightZone8;
@@ -70,6 +74,7 @@ class dscClassicKeypadInterface {
 
     void zoneLight(Light lightZone, byte zoneBit);
     void panelLight(Light lightPanel, byte zoneBit);
+    static void bufferKey(byte keyValue);
 
     Stream* stream;
     byte panelLights = 0x80, previousLights = 0x80;
@@ -89,8 +94,11 @@ class dscClassicKeypadInterface {
     static int clockInterval;
     static byte dscClockPin, dscReadPin, dscWritePin;
     static volatile byte keyData;
-    static volatile byte keyBufferLength;
-    static volatile byte keyBuffer[dscBufferSize];
+    static volatile byte keyBufferIndex, keyBufferLength;
+    static volatile byte keyBuffer[dscBufferSize], keyBufferRepeat[dscBufferSize];
+    static volatile unsigned long keyBufferTime[dscBufferSize];
+    static volatile byte previousKey, keyRepeatCount;
+    static volatile bool keyReleased;
     static volatile bool commandReady, moduleDataDetected;
     static volatile bool alarmKeyDetected, alarmKeyResponsePending;
     static volatile byte clockCycleCount, clockCycleTotal;
@@ -27,16 +27,38 @@ const byte dscPartitions = 4;   // Maximum number of partitions - requires 19 by
 const byte dscZones = 4;        // Maximum number of zone groups, 8 zones per group - requires 6 bytes of memory per zone group
 const byte dscBufferSize = 10;  // Number of commands to buffer if the sketch is busy - requires dscReadSize + 2 bytes of memory per command
 const byte dscReadSize = 16;    // Maximum bytes of a Keybus command
+const byte dscEventBufferSize = 2;  // Number of downloaded event buffer entries to store until read by handleEvent() - requires 10 bytes of memory per event
+const byte dscKeyBufferSize = 24;   // Number of keys to buffer for virtual keypad writes - requires 3 bytes of memory per key
+const byte dscWriteSlots = 4;       // Number of partition keys written in a single status command
+const byte dscWriteTicketSize = 1;  // Number of write timings to store until read by handleWriteTicket() - requires 22 bytes of memory per write
+const byte dscModuleBufferSize = 2; // Number of keypad and module commands to buffer if processModuleData is enabled - requires dscReadSize + 4 bytes of memory per command
+const byte dscSlotTimes = 1;        // Number of keypad and zone expander slots with a separate response time, 1 for the last response from any slot - requires 8 bytes of memory per slot
+const byte dscInstances = 1;        // Number of interfaces that can run at the same time, each with its own Keybus pins and timer
 #elif defined(ESP8266)
 const byte dscPartitions = 8;
 const byte dscZones = 8;
 const byte dscBufferSize = 50;
 const byte dscReadSize = 16;
+const byte dscEventBufferSize = 32;
+const byte dscKeyBufferSize = 64;
+const byte dscWriteSlots = 4;
+const byte dscWriteTicketSize = 16;
+const byte dscModuleBufferSize = 50;
+const byte dscSlotTimes = 8;
+const byte dscInstances = 1;
 #elif defined(ESP32)
 const byte dscPartitions = 8;
 const byte dscZones = 8;
 const DRAM_ATTR byte dscBufferSize = 50;
 const DRAM_ATTR byte dscReadSize = 16;
+const byte dscEventBufferSize = 32;
+const byte dscKeyBufferSize = 64;
+const DRAM_ATTR byte dscWriteSlots = 4;
+const byte dscWriteTicketSize = 16;
+const DRAM_ATTR byte dscModuleBufferSize = 50;
+const byte dscSlotTimes = 8;
+const byte dscInstances = 2;
+const byte dscDecodeQueueSize = 8;  // Number of commands decoded by the decode task to queue until read by loop() - requires about 450 bytes of memory per command
 #endif
 
 // Exit delay target states
@@ -44,6 +66,77 @@ const DRAM_ATTR byte dscReadSize = 16;
 #define DSC_EXIT_AWAY 2
 #define DSC_EXIT_NO_ENTRY_DELAY 3
 
+// Keybus series detected by detectSeries()
+#define DSC_SERIES_UNKNOWN 0
+#define DSC_SERIES_POWERSERIES 1
+#define DSC_SERIES_CLASSIC 2
+
+// Virtual zone expanders are numbered 0-3 as in printModuleMessage(), expanders 1-3 are emulated
+const byte dscExpanders = 4;
+
+// Virtual zone expander zone states
+#define DSC_ZONE_OPEN 0
+#define DSC_ZONE_CLOSED 1
+#define DSC_ZONE_TAMPER 2
+
+// Virtual keypad macro step guards
+#define DSC_MACRO_WAIT_READY 0x01     // Waits until the partition is ready before writing the step keys
+#define DSC_MACRO_WAIT_ARMED 0x02     // Waits until the partition is armed
+#define DSC_MACRO_WAIT_DISARMED 0x04  // Waits until the partition is disarmed
+#define DSC_MACRO_WAIT_PROMPT 0x08    // Waits until the panel requests an access code
+#define DSC_MACRO_ABORT_ALARM 0x10    // Stops the macro if the partition is in alarm
+#define DSC_MACRO_ABORT_ARMED 0x20    // Stops the macro if the partition is armed
+
+// Virtual keypad macro results
+#define DSC_MACRO_COMPLETE 1
+#define DSC_MACRO_ABORTED 2
+#define DSC_MACRO_TIMEOUT 3
+
+// LCD keypad data from panel command 0x6E (display) and keypad data entry during panel command 0x70
+struct dscLCDData {
+  byte data[4];    // Digits 1-8, 2 digits per byte
+  bool decimal;    // True if the panel requests 3 digit decimal input, stored in data[0]
+  char digits[9];  // Data as a string: 8 hex digits, or 3 digits if decimal is true
+};
+
+// Event buffer entry from panel commands 0xAA and 0xEC
+struct dscEvent {
+  unsigned int number;  // Event number, 1 is the most recent event
+  byte year;            // 2 digit year
+  byte month, day, hour, minute;
+  byte partition;       // 0 if the event is not partition-specific
+  byte statusSet;       // Selects the set of status messages: printPanelStatus0()...printPanelStatus1B()
+  byte status;
+};
+
+// Write timing for a write handle from write() or setTime(), in milliseconds from millis()
+struct dscWriteTicket {
+  byte handle;                 // Write handle returned by write()
+  byte keyCount, keysWritten;
+  unsigned long queueTime;     // Keys copied to the key buffer
+  unsigned long startTime;     // First bit of the first key written on the Keybus, 0 if no keys were written
+  unsigned long completeTime;  // Last bit of the last key written on the Keybus
+  unsigned long waitTime;      // Time spent waiting for the panel to respond to '*' keys
+  byte retries;                // Keys rewritten after a collision with another keypad
+  byte keysFailed;             // Keys with a collision after all retries
+  bool complete;
+};
+
+// Virtual keypad macro step for runMacro(): waits for the guards, writes the keys, then waits for the delay
+struct dscMacroStep {
+  const char *keys;    // Keys to write, NULL or empty to only wait for the guards
+  byte guards;         // DSC_MACRO_WAIT_* and DSC_MACRO_ABORT_* flags
+  unsigned int delay;  // Milliseconds to wait after the keys are written
+};
+
+// Status message text stored in PROGMEM, see dscKeybusMessages.h
+struct dscMessage {
+  byte code;
+  const char *text;
+};
+
+#define dscMessageCount(messages) (sizeof(messages) / sizeof(messages[0]))
+
 
 class dscKeybusInterface {
 
@@ -51,28 +144,38 @@ class dscKeybusInterface {
 
     // Initializes writes as disabled by default
     dscKeybusInterface(byte setClockPin, byte setReadPin, byte setWritePin = 255);
+    ~dscKeybusInterface();
 
     // Interface control
-    void begin(Stream &_stream = Serial);             // Initializes the stream output to Serial by default
-    bool loop();                                      // Returns true if valid panel data is available
+    bool begin(Stream &_stream = Serial);             // Initializes the stream output to Serial by default, returns false if dscInstances interfaces are already running
+    bool loop();                                      // Returns true if valid panel data is available, false if the interface is not started
     void stop();                                      // Disables the clock hardware interrupt and data timer interrupt
     void resetStatus();                               // Resets the state of all status components as changed for sketches to get the current status
 
-    // Writes a single key - nonblocking unless a previous write is in progress
-    void write(const char receivedKey);
+    // Samples the Keybus before begin() and returns the panel series: DSC_SERIES_POWERSERIES, DSC_SERIES_CLASSIC, or
+    // DSC_SERIES_UNKNOWN if the series could not be determined before the timeout.  On esp8266/esp32, define
+    // dscAutoSeries before including dscKeybusInterface.h to build both dscKeybusInterface and dscClassicInterface
+    // and begin() the interface for the detected series.
+    static byte detectSeries(byte clockPin, byte pc16Pin = 255, unsigned long timeout = 3000);
 
-    // Writes multiple keys from a char array
-    //
-    // By default, this is nonblocking unless there is a previous write in progress - in this case, the sketch must keep the char
-    // array defined at least until the write is complete.
+    // Writes a single key - nonblocking, returns a write handle or 0 if the key buffer is full
+    byte write(const char receivedKey);
+
+    // Writes multiple keys from a char array - nonblocking, returns a write handle or 0 if the key buffer is full
     //
-    // If the char array is ephemeral, check if the write is complete by checking writeReady or set blockingWrite to true to
-    // block until the write is complete.
-    void write(const char * receivedKeys, bool blockingWrite = false);
+    // Keys are copied to the key buffer for the current writePartition (or the partition selected by '/' in the keys)
+    // and written by loop(), so the char array can be ephemeral.  Check if the write is complete with writeComplete()
+    // or set blockingWrite to true to block until the write is complete.
+    byte write(const char * receivedKeys, bool blockingWrite = false);
+    bool writeComplete(byte writeHandle);             // True if all keys from the write handle have been written
 
     // Write control
-    static byte writePartition;                       // Set to a partition number for virtual keypad
-    bool writeReady;                                  // True if the library is ready to write a key
+    byte writePartition;                              // Set to a partition number for virtual keypad
+    bool writeReady;                                  // True if the key buffer is empty and no write is in progress
+
+    // Write timing - completed writes are stored until read, the oldest are replaced if not read
+    bool handleWriteTicket();                         // Returns true if a completed write is available in writeTicket
+    dscWriteTicket writeTicket;
 
     // Prints output to the stream interface set in begin()
     void printPanelBinary(bool printSpaces = true);   // Includes spaces between bytes by default
@@ -81,18 +184,56 @@ class dscKeybusInterface {
     void printModuleBinary(bool printSpaces = true);  // Includes spaces between bytes by default
     void printModuleMessage();                        // Prints the decoded keypad or module message
 
+    // Prints machine-readable output to the stream interface set in begin(), see dscKeybusPrintJSON.cpp for the formats
+    void printPanelJSON();                            // Prints the panel message as a single line JSON object
+    void printModuleJSON();                           // Prints the keypad or module message as a single line JSON object
+    void printPanelFrame();                           // Writes the panel message as a length-prefixed binary frame
+    void printModuleFrame();                          // Writes the keypad or module message as a length-prefixed binary frame
+
     // These can be configured in the sketch setup() before begin()
     bool hideKeypadDigits;          // Controls if keypad digits are hidden for publicly posted logs (default: false)
-    static bool processModuleData;  // Controls if keypad and module data is processed and displayed (default: false)
+    bool processModuleData;         // Controls if keypad and module data is processed and displayed (default: false)
+    byte writeRetryLimit;           // Number of times a key is rewritten after a collision with another keypad (default: 2)
     bool displayTrailingBits;       // Controls if bits read as the clock is reset are displayed, appears to be spurious data (default: false)
+    unsigned int macroTimeout;      // Milliseconds a macro step waits for its guards before the macro times out (default: 10000)
+    byte virtualExpanders;          // Zone expanders 1-3 emulated using the virtual keypad write pin, 1 bit per expander (default: 0)
 
     // Panel time
     bool timestampChanged;          // True after the panel sends a timestamped message
     byte hour, minute, day, month;
     int year;
 
-    // Sets panel time, the year can be sent as either 2 or 4 digits, returns true if the panel is ready to set the time
-    bool setTime(unsigned int year, byte month, byte day, byte hour, byte minute, const char* accessCode, byte timePartition = 1);
+    // Sets panel time, the year can be sent as either 2 or 4 digits.  The time is set in the background by loop(),
+    // returns a write handle for writeComplete() and handleWriteTicket(), or 0 if the panel is not ready to set the time
+    byte setTime(unsigned int year, byte month, byte day, byte hour, byte minute, const char* accessCode, byte timePartition = 1);
+
+    // Returns true if the time differs from the panel time by more than maxDrift minutes, or if the panel has not yet
+    // sent the time.  The panel sends the time periodically, the difference in minutes is stored in timeDrift.
+    bool timeSyncRequired(unsigned int year, byte month, byte day, byte hour, byte minute, byte maxDrift = 2);
+    long timeDrift;
+
+    // Event buffer download - pages through the panel event buffer as a virtual keypad, starting from the most recent
+    // event and stopping at the first event already downloaded.  Returns true if the download is started.
+    bool downloadEvents(byte eventPartition = 1, unsigned int maxEvents = 500);
+    bool downloadingEvents;         // True while the event buffer download is in progress
+    bool handleEvent();             // Returns true if a downloaded event is available in bufferEvent
+    dscEvent bufferEvent;
+
+    // Virtual zone expanders - sets the state of zones 9-32 on the zone expanders enabled in virtualExpanders, 8 zones
+    // per expander numbered as in printModuleMessage(): expander 1 is zones 9-16, expander 2 is zones 17-24, and
+    // expander 3 is zones 25-32.  The panel is notified of the change during the next status command and queries the
+    // expander for the zone states.  Expander 0 (zones 1-8, query 0x22) and expanders 4-7 (zones 33-64, query 0xE6)
+    // use a different response checksum and are not emulated.  Returns false if the zone expander is not enabled.
+    bool setZone(byte zone, byte zoneState);  // DSC_ZONE_OPEN, DSC_ZONE_CLOSED, or DSC_ZONE_TAMPER
+
+    // Virtual keypad macros - runs the steps of a dscMacroStep array from loop(), writing the keys of each step once
+    // the step guards are met.  The array must remain in memory while the macro runs.  Returns true if the macro is started.
+    bool runMacro(const dscMacroStep steps[], byte stepCount, byte stepPartition = 1);
+    void stopMacro();               // Stops the macro and removes its keys that have not been written
+    bool macroRunning;              // True while a macro is running
+    bool macroChanged;              // True after a macro completes or stops
+    byte macroResult;               // DSC_MACRO_COMPLETE, DSC_MACRO_ABORTED, or DSC_MACRO_TIMEOUT
+    byte macroStep;                 // Current step, or the step where the macro stopped
 
     // Status tracking
     bool statusChanged;                   // True after any status change
@@ -102,6 +243,8 @@ class dscKeybusInterface {
     bool accessCodeChanged[dscPartitions];
     bool accessCodePrompt;                // True if the panel is requesting an access code
     bool decimalInput;                    // True if the panel is requesting 3 digit input (for 0x6E readout)
+    dscLCDData lcdDisplay, lcdEntry;      // LCD keypad data shown by the panel (0x6E) and entered on a keypad (0x70, requires processModuleData)
+    bool lcdDisplayChanged, lcdEntryChanged;
     bool trouble, troubleChanged;
     bool powerTrouble, powerChanged;
     bool batteryTrouble, batteryChanged;
@@ -123,6 +266,28 @@ class dscKeybusInterface {
     byte pgmOutputs[2], pgmOutputsChanged[2];
     byte panelVersion;
 
+    // Extended status tracking from 0xE6 subcommands and the equivalent commands for partitions 1-2
+    bool timeTrouble, timeChanged;                    // Loss of system time
+    bool communicationTrouble, communicationChanged;  // Fail to communicate
+    byte lightsFlashing[dscPartitions];               // Status lights flashing, using the same bits as lights[]
+    bool lightsFlashingChanged[dscPartitions];
+    bool flashingZonesStatusChanged;
+    byte flashingZones[dscZones], flashingZonesChanged[dscZones];  // Zone lights flashing, 1 bit per zone
+    bool programZonesStatusChanged;
+    byte programZones[dscZones], programZonesChanged[dscZones];    // Zone lights in programming menus (bypassed zones, zone options), 1 bit per zone
+    byte enabledZones[dscPartitions][dscZones];                    // Zones enabled per partition, 1 bit per zone
+    bool enabledZonesChanged[dscPartitions];
+    byte keypadBeeps[dscPartitions], keypadTone[dscPartitions], keypadBuzzer[dscPartitions];
+    bool keypadSoundChanged[dscPartitions];                        // True after a beep, tone, or buzzer command for the partition
+
+    // Keypad and zone expander slots that responded to panel queries, requires processModuleData.  Slots missing from
+    // a 0x11 supervision response are cleared, so a keypad or zone expander that stops responding is detected within
+    // one supervision cycle.
+    byte keypadSlots;                                   // Keypad slots 1-8, 1 bit per slot (bit 0: slot 1)
+    byte expanderSlots;                                 // Zone expanders 0-7 as numbered by printModuleMessage(), 1 bit per expander
+    bool moduleSlotsChanged;
+    unsigned long keypadSlotTime[dscSlotTimes], expanderSlotTime[dscSlotTimes];  // millis() when each slot last responded to a query, Arduino/AVR: any slot in [0]
+
     /* panelData[] and moduleData[] store panel and keypad/module data in an array: command [0], stop bit by itself [1],
      * followed by the remaining data.  These can be accessed directly in the sketch to get data that is not already
      * tracked in the library.  See dscKeybusPrintData.cpp for the currently known DSC commands and data.
@@ -132,8 +297,9 @@ class dscKeybusInterface {
      *   00000101 0 10000001 00000001 10010001 11000111 [0x05] Partition 1: Ready Backlight - Partition ready | Partition 2: disabled
      *            ^ Byte 1 (stop bit)
      */
-    static byte panelData[dscReadSize];
-    static volatile byte moduleData[dscReadSize];
+    byte panelData[dscReadSize];
+    volatile byte moduleData[dscReadSize];
+    volatile byte moduleCmd, moduleSubCmd;  // Panel command and 0xE6 subcommand sent with the keypad/module data
 
     // status[] and lights[] store the current status message and LED state for each partition.  These can be accessed
     // directly in the sketch to get data that is not already tracked in the library.  See printPanelMessages() and
@@ -141,14 +307,26 @@ class dscKeybusInterface {
     byte status[dscPartitions];
     byte lights[dscPartitions];
 
-    // Process keypad and module data, returns true if data is available
+    // Process keypad and module data, returns true if data is available.  Keypad and module data is buffered with the
+    // panel command it was sent during, call handleModule() until it returns false to read all buffered data.
     bool handleModule();
 
-    // True if dscBufferSize needs to be increased
-    static volatile bool bufferOverflow;
+    // True if dscBufferSize, dscModuleBufferSize, or dscDecodeQueueSize needs to be increased
+    volatile bool bufferOverflow;
 
-    // Timer interrupt function to capture data - declared as public for use by AVR Timer1
-    static void dscDataInterrupt();
+    // esp32: set decodeTask to true before begin() to decode panel data in a task pinned to core 0, leaving the
+    // sketch core free for network handling.  The task decodes each command on its own copy of the status, and
+    // loop() copies the command to panelData[] and the resulting status to the status components on the sketch core,
+    // so the status components and print functions are used as usual.
+    #if defined(ESP32)
+    bool decodeTask;
+    #endif
+
+    // Timer interrupt functions to capture data for each interface - declared as public for use by AVR Timer1
+    static void dscDataInterrupt0();
+    #if defined(ESP32)
+    static void dscDataInterrupt1();
+    #endif
 
     // Deprecated
     bool processRedundantData;  // Controls if repeated periodic commands are processed and displayed (default: false)
@@ -166,26 +344,52 @@ class dscKeybusInterface {
     void processPanel_0x2D();
     void processPanel_0x34();
     void processPanel_0x3E();
+    void processPanel_0x6E();
+    void processPanel_0x64_69();
+    void processPanel_0x75_7A();
+    void processPanel_0x7F_82();
     void processPanel_0x87();
     void processPanel_0xA5();
+    void processPanel_0xAA_EC();
+    void processPanel_0xB1();
     void processPanel_0xE6();
+    void processPanel_0xE6_0x01_06_20_21();
     void processPanel_0xE6_0x09();
     void processPanel_0xE6_0x0B();
     void processPanel_0xE6_0x0D();
     void processPanel_0xE6_0x0F();
+    void processPanel_0xE6_0x17_18();
     void processPanel_0xE6_0x1A();
     void processPanel_0xEB();
+    void processStarKeyWait(byte partitionIndex);
+    void processAccessCodePrompt(byte partitionIndex);
+    void resetAccessCodeWrite(byte partitionIndex);
     void processReadyStatus(byte partitionIndex, bool status);
     void processAlarmStatus(byte partitionIndex, bool status);
     void processExitDelayStatus(byte partitionIndex, bool status);
     void processEntryDelayStatus(byte partitionIndex, bool status);
     void processNoEntryDelayStatus(byte partitionIndex, bool status);
     void processZoneStatus(byte zonesByte, byte panelByte);
+    void processZoneLights(byte zones[], byte zonesChanged[], byte previousZones[], bool &zonesStatusChanged, byte startGroup, byte panelByte);
+    void processEnabledZones(byte partitionMask, byte panelByte, byte startGroup);
+    void processKeypadBeeps(byte partitionMask, byte panelByte);
+    void processKeypadTone(byte partitionMask, byte panelByte);
+    void processKeypadBuzzer(byte partitionMask, byte panelByte);
     void processTime(byte panelByte);
+    unsigned long dateMinutes(unsigned int year, byte month, byte day, byte hour, byte minute);
     void processAlarmZones(byte panelByte, byte startByte, byte zoneCountOffset, byte writeValue);
     void processAlarmZonesStatus(byte zonesByte, byte zoneCount, byte writeValue);
     void processArmed(byte partitionIndex, bool armedStatus);
     void processPanelAccessCode(byte partitionIndex, byte dscCode, bool accessCodeIncrease = true);
+    void processEventDownload();
+    void processMacro();
+    void endMacro(byte result);
+    bool processLCDData(dscLCDData &lcdData, byte dataBytes[]);
+    void processModuleSlots();
+    void processSlotPresence(byte &slots, unsigned long slotTime[], byte respondedSlots, bool supervision);
+    byte moduleSlots(byte startByte, byte endByte, byte startMask, byte endMask, byte bitShift, byte matchValue, bool reverse = false);
+    bool moduleSlotMatch(byte testByte, byte testMask, byte matchShift, byte matchValue, bool reverse);
+    bool sameEvent(dscEvent &event1, dscEvent &event2);
 
     void printPanelPartitionStatus(byte startPartition, byte startByte, byte endByte);
     void printPanelStatus0(byte panelByte);
@@ -202,7 +406,7 @@ class dscKeybusInterface {
 
     void printPanelMessages(byte panelByte);
     void printPanelLights(byte panelByte, bool printMessage = true);
-    void printPanelTime(byte panelByte);
+    void printPanelTime(byte panelByte, char dateSeparator = '.');
     void printPanelBeeps(byte panelByte);
     void printPanelTone(byte panelByte);
     void printPanelBuzzer(byte panelByte);
@@ -211,6 +415,7 @@ class dscKeybusInterface {
     void printPanelBitNumbers(byte panelByte, byte startNumber, byte startBit = 0, byte stopBit = 7, bool printNone = true);
     void printNumberSpace(byte number);
     void printNumberOffset(byte panelByte, int numberOffset);
+    bool printPanelText(const dscMessage messages[], byte messageCount, byte panelByte);
     void printUnknownData();
     void printPartition();
     void printStatusLights();
@@ -288,20 +493,72 @@ class dscKeybusInterface {
     bool printModuleSlots(byte startCount, byte startByte, byte endByte, byte startMask, byte endMask, byte bitShift, byte matchValue, bool reverse = false);
     void printModuleProgramming(byte panelByte2, byte panelByte3);
 
+    bool panelCRC();
+    void decodePanelTime(byte panelByte, byte &timeYear, byte &timeMonth, byte &timeDay, byte &timeHour, byte &timeMinute);
+    bool hiddenModuleByte(byte moduleByte);
+    void printFrameHeader(byte frameType, byte byteCount, byte bitCount, byte frameInfo);
+    void printJSONHex(byte value);
+    void printJSONPartitions(byte startPartition, byte startByte, byte partitionCount);
+    void printJSONZones(byte panelByte, byte startZone);
+    void printJSONStatus(byte statusSet, byte panelByte);
+    void printJSONTime(byte panelByte);
+
     bool validCRC();
-    void writeKeys(const char * writeKeysArray);
-    void setWriteKey(const char receivedKey);
-    static void dscClockInterrupt();
+    bool processPanelData();
+    bool readPanelData(byte data[], byte &bitCount, byte &byteCount);
+    bool decodePanelData();
+    byte bufferKeys(const char * receivedKeys, byte keyPartition);
+    void writeKeys();
+    bool writeKeysPending();
+    void processWriteTickets();
+    void processWriteKey(byte keyHandle, byte writeSlot);
+    bool setWriteKey(const char receivedKey, byte keyPartition, byte keyHandle);
+    void dscClockInterrupt();
+    void dscDataInterrupt();
     static bool redundantPanelData(byte previousCmd[], volatile byte currentCmd[], byte checkedBytes = dscReadSize);
+    void setWritePlan(byte startSlot);
+    void setExpanderChecksum(byte expander);
+    bool writeAlarmKey(const char receivedKey);
+
+    // Interrupts call the interface running on their Keybus pins through these functions
+    static dscKeybusInterface * instances[dscInstances];
+    static void dscClockInterrupt0();
+    #if defined(ESP32)
+    static void dscClockInterrupt1();
+    #endif
+    byte instance;
+    bool interfaceStarted;
 
     #if defined(ESP32)
-    static hw_timer_t * timer1;
-    static portMUX_TYPE timer1Mux;
+    hw_timer_t * timer1 = NULL;
+    portMUX_TYPE timer1Mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // The decode task decodes commands on the decoder interface and passes each command with the resulting status to
+    // loop() as a dscDecodeRecord through a single producer/single consumer queue: the task only writes
+    // decodeQueueHead and loop() only writes decodeQueueTail.  The decoder records the write state changes of a
+    // command in starKeyAcks, accessCodePrompts, and accessCodeResets (1 bit per partition) for loop() to apply.
+    struct dscDecodeRecord;
+    static void decodeTaskLoop(void * parameter);
+    bool processDecodeQueue();
+    void saveDecodedStatus(dscDecodeRecord &record);
+    void loadDecodedStatus(dscDecodeRecord &record);
+    TaskHandle_t decodeTaskHandle = NULL;
+    dscKeybusInterface * decoder = NULL;
+    dscDecodeRecord * decodeQueue = NULL;
+    volatile byte decodeQueueHead, decodeQueueTail;
+    bool decodeOnly = false;  // True for the decoder interface of the decode task
+    byte starKeyAcks, accessCodePrompts, accessCodeResets;
     #endif
 
     Stream* stream;
-    const char* writeKeysArray;
-    bool writeKeysPending;
+    char keyBuffer[dscKeyBufferSize];
+    byte keyBufferPartition[dscKeyBufferSize], keyBufferHandle[dscKeyBufferSize];
+    byte keyBufferIndex, keyBufferLength;
+    byte writeHandle, writeKeyHandle[dscWriteSlots + 1];  // Partition write slots and the alarm key slot
+    bool writeSlotActive[dscWriteSlots + 1];
+    unsigned long writeWaitTime[dscWriteSlots + 1];
+    dscWriteTicket writeTickets[dscWriteTicketSize];
+    bool setPartition;
     bool writeAccessCode[dscPartitions];
     bool queryResponse;
     bool previousTrouble;
@@ -318,26 +575,102 @@ class dscKeybusInterface {
     bool previousFire[dscPartitions];
     byte previousOpenZones[dscZones], previousAlarmZones[dscZones];
     byte previousPgmOutputs[2];
+    bool previousTimeTrouble, previousCommunication;
+    byte previousLightsFlashing[dscPartitions];
+    byte previousFlashingZones[dscZones], previousProgramZones[dscZones];
+    byte previousEnabledZones[dscPartitions][dscZones];
+    dscEvent events[dscEventBufferSize];
+    dscEvent newestEvent, downloadedEvent;
+    byte eventIndex, eventCount;
+    bool eventDownloaded, eventFinishing;
+    char eventKey, eventLastKey;
+    byte eventRetries, eventKeyPartition;
+    unsigned int eventTotal, eventMax, eventPreviousNumber;
+    unsigned long eventRequestTime;
+    bool timeReceived;
+    const dscMacroStep *macroSteps;
+    byte macroStepCount, macroPartition, macroState, macroHandle;
+    unsigned long macroTime;
+    unsigned long timeMinutes, timeReceivedTime;
+    byte panelBufferIndex = 1;
+    bool startupCycle = true;
+    byte previousCmd0A[dscReadSize], previousCmd0F[dscReadSize], previousCmdE6_03[dscReadSize];
+    byte previousCmdE6_20[dscReadSize], previousCmdE6_21[dscReadSize];
+    unsigned long previousWriteKeyTime;
+
+    byte dscClockPin;
+    byte dscReadPin;
+    byte dscWritePin;
+    byte writeKeyPartition[dscWriteSlots + 1];
+    bool virtualKeypad;
+    char writeKey[dscWriteSlots + 1];
+    byte panelBitCount, panelByteCount;
+    volatile bool writeKeyPending[dscWriteSlots + 1];
+    volatile bool writeAlarm, writeAlarmAck, starKeyCheck[dscWriteSlots], starKeyWait[dscPartitions];
+    volatile bool writeVerify, writeVerifyLevel, writeVerifyEnd, writeCollision, writeFailed[dscWriteSlots + 1];
+    volatile byte writeVerifySlot, writeRetries[dscWriteSlots + 1];
+    byte writePlanCmd[dscWriteSlots], writePlanBit[dscWriteSlots];
+    volatile byte writePlanSlot, writePlanStart;
     bool keybusVersion1;
+    volatile byte expanderData[dscExpanders][5];  // Zone expander query responses: zones 1-4, previous zones 1-4, zones 5-8, previous zones 5-8, checksum
+    volatile byte expanderNotify;      // Zone expanders with zone changes not yet queried by the panel
+    volatile bool moduleDataDetected;
+    volatile unsigned long clockHighTime, keybusTime;
+    volatile unsigned long writeStartTime[dscWriteSlots + 1], writeEndTime[dscWriteSlots + 1];
+    volatile byte panelBufferLength;
+    volatile byte panelBuffer[dscBufferSize][dscReadSize];
+    volatile byte panelBufferBitCount[dscBufferSize], panelBufferByteCount[dscBufferSize];
+    volatile byte moduleBitCount, moduleByteCount;
+    volatile byte currentCmd, statusCmd;
+    volatile byte isrPanelData[dscReadSize], isrPanelBitTotal, isrPanelBitCount, isrPanelByteCount;
+    volatile byte isrModuleData[dscReadSize];
+    volatile byte moduleBuffer[dscModuleBufferSize][dscReadSize];
+    volatile byte moduleBufferCmd[dscModuleBufferSize], moduleBufferSubCmd[dscModuleBufferSize];
+    volatile byte moduleBufferBitCount[dscModuleBufferSize], moduleBufferByteCount[dscModuleBufferSize];
+    volatile byte moduleBufferIndex, moduleBufferLength;
+    unsigned long previousClockHighTime;
+    bool skipData, writeStart, writeRepeat, writeAlarmCmd, writeAlarmRepeated;
+    byte writeBits;
+    byte previousCmd05[dscReadSize], previousCmd1B[dscReadSize];
+    byte isrExpander = dscExpanders;  // Zone expander being queried by the panel, dscExpanders outside of a query for an enabled zone expander
+};
+
 
-    static byte dscClockPin;
-    static byte dscReadPin;
-    static byte dscWritePin;
-    static byte writeByte, writeBit;
-    static bool virtualKeypad;
-    static char writeKey;
-    static byte panelBitCount, panelByteCount;
-    static volatile bool writeKeyPending;
-    static volatile bool writeAlarm, starKeyCheck, starKeyWait[dscPartitions];
-    static volatile bool moduleDataDetected, moduleDataCaptured;
-    static volatile unsigned long clockHighTime, keybusTime;
-    static volatile byte panelBufferLength;
-    static volatile byte panelBuffer[dscBufferSize][dscReadSize];
-    static volatile byte panelBufferBitCount[dscBufferSize], panelBufferByteCount[dscBufferSize];
-    static volatile byte moduleBitCount, moduleByteCount;
-    static volatile byte currentCmd, statusCmd, moduleCmd, moduleSubCmd;
-    static volatile byte isrPanelData[dscReadSize], isrPanelBitTotal, isrPanelBitCount, isrPanelByteCount;
-    static volatile byte isrModuleData[dscReadSize];
+#if defined(ESP32)
+// Status components set by the decode task for loop() - values are copied, and changed flags are merged with the
+// flags not yet cleared by the sketch
+#define dscDecodedValues(component) \
+  component(accessCode) component(decimalInput) component(lcdDisplay) component(trouble) component(powerTrouble) \
+  component(batteryTrouble) component(ready) component(disabled) component(armed) component(armedAway) \
+  component(armedStay) component(noEntryDelay) component(alarm) component(exitDelay) component(exitState) \
+  component(entryDelay) component(fire) component(openZones) component(alarmZones) component(pgmOutputs) \
+  component(panelVersion) component(timeTrouble) component(communicationTrouble) component(lightsFlashing) \
+  component(flashingZones) component(programZones) component(enabledZones) component(keypadBeeps) \
+  component(keypadTone) component(keypadBuzzer) component(status) component(lights) component(hour) \
+  component(minute) component(day) component(month) component(year) component(timeReceived) \
+  component(timeMinutes) component(timeReceivedTime) component(keybusVersion1)
+
+#define dscDecodedFlags(component) \
+  component(statusChanged) component(accessCodeChanged) component(lcdDisplayChanged) component(troubleChanged) \
+  component(powerChanged) component(batteryChanged) component(keypadFireAlarm) component(keypadAuxAlarm) \
+  component(keypadPanicAlarm) component(readyChanged) component(disabledChanged) component(armedChanged) \
+  component(alarmChanged) component(exitDelayChanged) component(exitStateChanged) component(entryDelayChanged) \
+  component(fireChanged) component(openZonesStatusChanged) component(openZonesChanged) \
+  component(alarmZonesStatusChanged) component(alarmZonesChanged) component(pgmOutputsStatusChanged) \
+  component(pgmOutputsChanged) component(timeChanged) component(communicationChanged) \
+  component(lightsFlashingChanged) component(flashingZonesStatusChanged) component(flashingZonesChanged) \
+  component(programZonesStatusChanged) component(programZonesChanged) component(enabledZonesChanged) \
+  component(keypadSoundChanged) component(timestampChanged)
+
+#define dscDecodedSize(component) + sizeof(dscKeybusInterface::component)
+
+// A command decoded by the decode task and the status after the command
+struct dscKeybusInterface::dscDecodeRecord {
+  byte panelData[dscReadSize];
+  byte panelBitCount, panelByteCount;
+  byte starKeyAcks, accessCodePrompts, accessCodeResets;
+  byte status[0 dscDecodedValues(dscDecodedSize) dscDecodedFlags(dscDecodedSize)];
 };
+#endif
 
 #endif // dscKeybus_h
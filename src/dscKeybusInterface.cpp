@@ -19,11 +19,10 @@
 
 #include "dscKeybus.h"
 
-
 #if defined(ESP32)
-portMUX_TYPE dscKeybusInterface::timer1Mux = portMUX_INITIALIZER_UNLOCKED;
-hw_timer_t * dscKeybusInterface::timer1 = NULL;
-#endif  // ESP32
+#include <new>
+#endif
+
 
 
 dscKeybusInterface::dscKeybusInterface(byte setClockPin, byte setReadPin, byte setWritePin) {
@@ -35,16 +34,86 @@ dscKeybusInterface::dscKeybusInterface(byte setClockPin, byte setReadPin, byte s
   processRedundantData = true;
   displayTrailingBits = false;
   processModuleData = false;
+  writeRetryLimit = 2;
+  macroTimeout = 10000;
+  writePlanSlot = dscWriteSlots;
+  virtualExpanders = 0;
+
+  // Sets the virtual zone expander zones as closed
+  for (byte expander = 0; expander < dscExpanders; expander++) {
+    for (byte zoneByte = 0; zoneByte < 4; zoneByte++) expanderData[expander][zoneByte] = 0x55;
+    setExpanderChecksum(expander);
+  }
   writePartition = 1;
   pauseStatus = false;
+  interfaceStarted = false;
+  #if defined(ESP32)
+  decodeTask = false;
+  decodeQueueHead = 0;
+  decodeQueueTail = 0;
+  starKeyAcks = 0;
+  accessCodePrompts = 0;
+  accessCodeResets = 0;
+  #endif
+
+  // Registers the interface for the interrupt functions, up to dscInstances interfaces
+  instance = dscInstances;
+  for (byte i = 0; i < dscInstances; i++) {
+    if (instances[i] == NULL) {
+      instances[i] = this;
+      instance = i;
+      break;
+    }
+  }
 }
 
 
-void dscKeybusInterface::begin(Stream &_stream) {
+// Releases the interface slot used by the interrupt functions
+dscKeybusInterface::~dscKeybusInterface() {
+  stop();
+  if (instance < dscInstances) {
+    #if defined(ESP32)
+    portENTER_CRITICAL(&timer1Mux);
+    #else
+    noInterrupts();
+    #endif
+
+    instances[instance] = NULL;
+
+    #if defined(ESP32)
+    portEXIT_CRITICAL(&timer1Mux);
+    #else
+    interrupts();
+    #endif
+  }
+}
+
+
+bool dscKeybusInterface::begin(Stream &_stream) {
+  stream = &_stream;
+
+  // Skips interfaces beyond dscInstances
+  if (instance >= dscInstances) {
+    stream->println(F("dscKeybusInterface: dscInstances interfaces are already running"));
+    return false;
+  }
+
   pinMode(dscClockPin, INPUT);
   pinMode(dscReadPin, INPUT);
   if (virtualKeypad) pinMode(dscWritePin, OUTPUT);
-  stream = &_stream;
+
+  // Selects the interrupt functions for this interface
+  // Arduino/AVR reaches the data interrupt function through ISR(TIMER1_OVF_vect)
+  void (*clockInterrupt)() = dscClockInterrupt0;
+  #if defined(ESP8266) || defined(ESP32)
+  void (*dataInterrupt)() = dscDataInterrupt0;
+  #endif
+  #if defined(ESP32)
+  if (instance == 1) {
+    clockInterrupt = dscClockInterrupt1;
+    dataInterrupt = dscDataInterrupt1;
+  }
+  #endif
 
   // Platform-specific timers trigger a read of the data line 250us after the Keybus clock changes
 
@@ -57,24 +126,62 @@ void dscKeybusInterface::begin(Stream &_stream) {
   // esp8266 timer1 calls dscDataInterrupt() from dscClockInterrupt() as a one-shot timer
   #elif defined(ESP8266)
   timer1_isr_init();
-  timer1_attachInterrupt(dscDataInterrupt);
+  timer1_attachInterrupt(dataInterrupt);
   timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
 
-  // esp32 timer1 calls dscDataInterrupt() from dscClockInterrupt()
+  // esp32 timer1 (timer2 for the second interface) calls dscDataInterrupt() from dscClockInterrupt()
   #elif defined(ESP32)
-  timer1 = timerBegin(1, 80, true);
+  timer1 = timerBegin(1 + instance, 80, true);
   timerStop(timer1);
-  timerAttachInterrupt(timer1, &dscDataInterrupt, true);
+  timerAttachInterrupt(timer1, dataInterrupt, true);
   timerAlarmWrite(timer1, 250, true);
   timerAlarmEnable(timer1);
   #endif
 
   // Generates an interrupt when the Keybus clock rises or falls - requires a hardware interrupt pin on Arduino/AVR
-  attachInterrupt(digitalPinToInterrupt(dscClockPin), dscClockInterrupt, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(dscClockPin), clockInterrupt, CHANGE);
+
+  // Starts the esp32 decode task on core 0, the Arduino loop runs on core 1.  The task decodes on a separate decoder
+  // interface that does not use an interrupt slot, so the status of this interface is only changed by loop().  The
+  // decoder is constructed in zeroed memory to start from the same state as an interface declared in the sketch, as
+  // the constructor does not set the status components and previous states.  Panel data is decoded by loop() if the
+  // memory is not available.
+  #if defined(ESP32)
+  if (decodeTask && decodeTaskHandle == NULL) {
+    void * decoderMemory = calloc(1, sizeof(dscKeybusInterface));
+    decodeQueue = (dscDecodeRecord *) calloc(dscDecodeQueueSize, sizeof(dscDecodeRecord));
+    if (decoderMemory == NULL || decodeQueue == NULL) {
+      free(decoderMemory);
+      free(decodeQueue);
+      decodeQueue = NULL;
+      stream->println(F("dscKeybusInterface: decode task memory unavailable, decoding in loop()"));
+    }
+    else {
+      decoder = new (decoderMemory) dscKeybusInterface(255, 255);
+      if (decoder->instance < dscInstances) {
+        portENTER_CRITICAL(&timer1Mux);
+        instances[decoder->instance] = NULL;
+        portEXIT_CRITICAL(&timer1Mux);
+        decoder->instance = dscInstances;
+      }
+      decoder->decodeOnly = true;
+      decoder->stream = stream;
+      decoder->processRedundantData = processRedundantData;
+      decodeQueueHead = 0;
+      decodeQueueTail = 0;
+      xTaskCreatePinnedToCore(decodeTaskLoop, "dscDecode", 4096, this, 1, &decodeTaskHandle, 0);
+    }
+  }
+  #endif
+
+  interfaceStarted = true;
+  return true;
 }
 
 
 void dscKeybusInterface::stop() {
+  if (!interfaceStarted) return;
+  interfaceStarted = false;
 
   // Disables Arduino/AVR Timer1 interrupts
   #if defined(__AVR__)
@@ -94,6 +201,21 @@ void dscKeybusInterface::stop() {
   // Disables the Keybus clock pin interrupt
   detachInterrupt(digitalPinToInterrupt(dscClockPin));
 
+  // Stops the esp32 decode task and releases the decoder
+  #if defined(ESP32)
+  if (decodeTaskHandle != NULL) {
+    vTaskDelete(decodeTaskHandle);
+    decodeTaskHandle = NULL;
+  }
+  if (decoder != NULL) {
+    decoder->~dscKeybusInterface();
+    free(decoder);
+    decoder = NULL;
+  }
+  free(decodeQueue);
+  decodeQueue = NULL;
+  #endif
+
   // Resets the panel capture data and counters
   panelBufferLength = 0;
   for (byte i = 0; i < dscReadSize; i++) isrPanelData[i] = 0;
@@ -106,7 +228,60 @@ void dscKeybusInterface::stop() {
 }
 
 
+// Polls the clock before the interrupts are attached: PowerSeries commands are mostly longer than the 16-bit Classic
+// series commands, and Classic series panels also send data on the PC16 line
+byte dscKeybusInterface::detectSeries(byte clockPin, byte pc16Pin, unsigned long timeout) {
+  pinMode(clockPin, INPUT);
+  if (pc16Pin != 255) pinMode(pc16Pin, INPUT);
+
+  bool frameStart = false, pc16High = false, pc16Low = false;
+  bool previousClock = digitalRead(clockPin);
+  byte frameBits = 0, shortFrames = 0, longFrames = 0;
+  unsigned long clockChangeTime = micros();
+  unsigned long startTime = millis();
+
+  while (millis() - startTime < timeout) {
+    bool clock = digitalRead(clockPin);
+    if (clock == previousClock) {
+      #if defined(ESP8266) || defined(ESP32)
+      if (micros() - clockChangeTime > 2000) yield();  // Yields only during the reset between commands or if the bus is idle
+      #endif
+      continue;
+    }
+
+    unsigned long clockTime = micros() - clockChangeTime;
+    clockChangeTime = micros();
+    previousClock = clock;
+
+    // Counts the bits in a command and checks for data on the PC16 line while the clock is high
+    if (clock) {
+      frameBits++;
+      if (pc16Pin != 255) {
+        if (digitalRead(pc16Pin) == HIGH) pc16High = true;
+        else pc16Low = true;
+      }
+    }
+
+    // Counts the command length after the clock is high for the reset between commands, skipping the first partial command
+    else if (clockTime > 1000) {
+      if (frameStart) {
+        if (frameBits > 20) longFrames++;
+        else if (frameBits >= 8) shortFrames++;
+      }
+      frameStart = true;
+      frameBits = 0;
+
+      if (longFrames >= 2) return DSC_SERIES_POWERSERIES;
+      if (longFrames == 0 && (shortFrames >= 8 || (shortFrames >= 4 && pc16High && pc16Low))) return DSC_SERIES_CLASSIC;
+    }
+  }
+
+  return DSC_SERIES_UNKNOWN;
+}
+
+
 bool dscKeybusInterface::loop() {
+  if (!interfaceStarted) return false;
 
   #if defined(ESP8266) || defined(ESP32)
   yield();
@@ -135,18 +310,155 @@ bool dscKeybusInterface::loop() {
     if (!keybusConnected) return true;
   }
 
-  // Writes keys when multiple keys are sent as a char array
-  if (writeKeysPending) writeKeys(writeKeysArray);
+  // Writes keys from the key buffer and tracks the timing of written keys
+  processWriteTickets();
+  if (keyBufferLength > 0) writeKeys();
+
+  // Pages through the event buffer during a download
+  if (downloadingEvents) processEventDownload();
+
+  // Runs the virtual keypad macro
+  if (macroRunning) processMacro();
+
+  // Applies a command decoded by the esp32 decode task
+  #if defined(ESP32)
+  if (decodeTaskHandle != NULL) return processDecodeQueue();
+  #endif
+
+  return processPanelData();
+}
+
+
+#if defined(ESP32)
+// Decodes commands on core 0 - the panel data buffer of the interface is read by the task, and the decoded command
+// and status are added to the queue for loop()
+void dscKeybusInterface::decodeTaskLoop(void * parameter) {
+  dscKeybusInterface * dsc = (dscKeybusInterface *) parameter;
+  dscKeybusInterface * decoder = dsc->decoder;
+
+  for (;;) {
+
+    // Waits a tick when the queue is full or the panel data buffer is empty to let other core 0 tasks run - panel
+    // data remains in the panel data buffer while loop() catches up with the queue
+    byte queueHead = dsc->decodeQueueHead;
+    byte nextHead = (queueHead + 1) % dscDecodeQueueSize;
+    if (nextHead == dsc->decodeQueueTail || !dsc->readPanelData(decoder->panelData, decoder->panelBitCount, decoder->panelByteCount)) {
+      vTaskDelay(1);
+      continue;
+    }
+
+    decoder->pauseStatus = dsc->pauseStatus;
+    decoder->starKeyAcks = 0;
+    decoder->accessCodePrompts = 0;
+    decoder->accessCodeResets = 0;
+    if (!decoder->decodePanelData()) continue;
+
+    // Adds the decoded command to the queue - the head is updated after the record is stored
+    dscDecodeRecord &record = dsc->decodeQueue[queueHead];
+    for (byte i = 0; i < dscReadSize; i++) record.panelData[i] = decoder->panelData[i];
+    record.panelBitCount = decoder->panelBitCount;
+    record.panelByteCount = decoder->panelByteCount;
+    record.starKeyAcks = decoder->starKeyAcks;
+    record.accessCodePrompts = decoder->accessCodePrompts;
+    record.accessCodeResets = decoder->accessCodeResets;
+    decoder->saveDecodedStatus(record);
+
+    __sync_synchronize();
+    dsc->decodeQueueHead = nextHead;
+  }
+}
+
+
+// Copies the next decoded command to panelData[] and the decoded status to the status components, and applies the
+// write state changes of the command
+bool dscKeybusInterface::processDecodeQueue() {
+  byte queueTail = decodeQueueTail;
+  if (queueTail == decodeQueueHead) return false;
+  __sync_synchronize();
+
+  dscDecodeRecord &record = decodeQueue[queueTail];
+  for (byte i = 0; i < dscReadSize; i++) panelData[i] = record.panelData[i];
+  panelBitCount = record.panelBitCount;
+  panelByteCount = record.panelByteCount;
+  loadDecodedStatus(record);
+
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (bitRead(record.starKeyAcks, partitionIndex)) processStarKeyWait(partitionIndex);
+    if (bitRead(record.accessCodeResets, partitionIndex)) resetAccessCodeWrite(partitionIndex);
+    if (bitRead(record.accessCodePrompts, partitionIndex)) processAccessCodePrompt(partitionIndex);
+  }
+
+  // Releases the record to the task
+  __sync_synchronize();
+  decodeQueueTail = (queueTail + 1) % dscDecodeQueueSize;
+
+  // Sets writeReady status
+  if (!writeKeysPending() && keyBufferLength == 0 && !downloadingEvents && !macroRunning) writeReady = true;
+  else writeReady = false;
+
+  // Processes the event buffer download
+  if (panelData[0] == 0xAA || panelData[0] == 0xEC) processPanel_0xAA_EC();
+
+  return true;
+}
+
+
+// Copies the decoded status to the record and clears the changed flags for the next command
+void dscKeybusInterface::saveDecodedStatus(dscDecodeRecord &record) {
+  byte * recordData = record.status;
+
+  #define dscSaveValue(component) \
+    memcpy(recordData, &component, sizeof(component)); \
+    recordData += sizeof(component);
+  dscDecodedValues(dscSaveValue)
+  #undef dscSaveValue
+
+  #define dscSaveFlag(component) \
+    memcpy(recordData, &component, sizeof(component)); \
+    memset(&component, 0, sizeof(component)); \
+    recordData += sizeof(component);
+  dscDecodedFlags(dscSaveFlag)
+  #undef dscSaveFlag
+}
+
+
+// Copies the decoded status from the record - changed flags are kept until cleared by the sketch
+void dscKeybusInterface::loadDecodedStatus(dscDecodeRecord &record) {
+  byte * recordData = record.status;
+
+  #define dscLoadValue(component) \
+    memcpy(&component, recordData, sizeof(component)); \
+    recordData += sizeof(component);
+  dscDecodedValues(dscLoadValue)
+  #undef dscLoadValue
+
+  #define dscLoadFlag(component) \
+    for (byte i = 0; i < sizeof(component); i++) ((byte *) &component)[i] |= recordData[i]; \
+    recordData += sizeof(component);
+  dscDecodedFlags(dscLoadFlag)
+  #undef dscLoadFlag
+}
+#endif
+
+
+// Copies the next command from the panel data buffer to panelData[] and decodes the status
+bool dscKeybusInterface::processPanelData() {
+  if (!readPanelData(panelData, panelBitCount, panelByteCount)) return false;
+  return decodePanelData();
+}
+
+
+// Copies the next command from the panel data buffer
+bool dscKeybusInterface::readPanelData(byte data[], byte &bitCount, byte &byteCount) {
 
   // Skips processing if the panel data buffer is empty
   if (panelBufferLength == 0) return false;
 
-  // Copies data from the buffer to panelData[]
-  static byte panelBufferIndex = 1;
+  // Copies data from the buffer
   byte dataIndex = panelBufferIndex - 1;
-  for (byte i = 0; i < dscReadSize; i++) panelData[i] = panelBuffer[dataIndex][i];
-  panelBitCount = panelBufferBitCount[dataIndex];
-  panelByteCount = panelBufferByteCount[dataIndex];
+  for (byte i = 0; i < dscReadSize; i++) data[i] = panelBuffer[dataIndex][i];
+  bitCount = panelBufferBitCount[dataIndex];
+  byteCount = panelBufferByteCount[dataIndex];
   panelBufferIndex++;
 
   // Resets counters when the buffer is cleared
@@ -167,8 +479,14 @@ bool dscKeybusInterface::loop() {
   interrupts();
   #endif
 
+  return true;
+}
+
+
+// Decodes the status from panelData[]
+bool dscKeybusInterface::decodePanelData() {
+
   // Waits at startup for the 0x05 status command or a command with valid CRC data to eliminate spurious data.
-  static bool startupCycle = true;
   if (startupCycle) {
     if (panelData[0] == 0) return false;
     else if (panelData[0] == 0x05 || panelData[0] == 0x1B) {
@@ -180,14 +498,10 @@ bool dscKeybusInterface::loop() {
   }
 
   // Sets writeReady status
-  if (!writeKeyPending && !writeKeysPending) writeReady = true;
+  if (!writeKeysPending() && keyBufferLength == 0 && !downloadingEvents && !macroRunning) writeReady = true;
   else writeReady = false;
 
   // Skips redundant data sent constantly while in installer programming
-  static byte previousCmd0A[dscReadSize];
-  static byte previousCmd0F[dscReadSize];
-  static byte previousCmdE6_20[dscReadSize];
-  static byte previousCmdE6_21[dscReadSize];
   switch (panelData[0]) {
     case 0x0A:  // Partition 1 status in programming
       if (redundantPanelData(previousCmd0A, panelData)) return false;
@@ -203,7 +517,6 @@ bool dscKeybusInterface::loop() {
       break;
   }
   if (dscPartitions > 4) {
-    static byte previousCmdE6_03[dscReadSize];
     if (panelData[0] == 0xE6 && panelData[2] == 0x03 && redundantPanelData(previousCmdE6_03, panelData, 8)) return false;  // Status in alarm/programming, partitions 5-8
   }
 
@@ -216,10 +529,20 @@ bool dscKeybusInterface::loop() {
     case 0x2D: processPanel_0x2D(); break;                         // Panel status and zones 9-16 status
     case 0x34: processPanel_0x34(); break;                         // Panel status and zones 17-24 status
     case 0x3E: processPanel_0x3E(); break;                         // Panel status and zones 25-32 status
+    case 0x64:                                                     // Beep, partition 1
+    case 0x69: processPanel_0x64_69(); break;                      // Beep, partition 2
+    case 0x6E: processPanel_0x6E(); break;                         // LCD keypad display
+    case 0x75:                                                     // Tone, partition 1
+    case 0x7A: processPanel_0x75_7A(); break;                      // Tone, partition 2
+    case 0x7F:                                                     // Buzzer, partition 1
+    case 0x82: processPanel_0x7F_82(); break;                      // Buzzer, partition 2
     case 0x87: processPanel_0x87(); break;                         // PGM outputs
     case 0xA5: processPanel_0xA5(); break;                         // Date, time, system status messages - partitions 1-2
+    case 0xAA: processPanel_0xAA_EC(); break;                      // Event buffer messages - partitions 1-2
+    case 0xB1: processPanel_0xB1(); break;                         // Enabled zones 1-32, partitions 1-2
     case 0xE6: if (dscPartitions > 2) processPanel_0xE6(); break;  // Extended status command split into multiple subcommands to handle up to 8 partitions/64 zones
     case 0xEB: if (dscPartitions > 2) processPanel_0xEB(); break;  // Date, time, system status messages - partitions 1-8
+    case 0xEC: processPanel_0xAA_EC(); break;                      // Event buffer messages - partitions 1-8
   }
 
   return true;
@@ -227,191 +550,410 @@ bool dscKeybusInterface::loop() {
 
 
 bool dscKeybusInterface::handleModule() {
-  if (!moduleDataCaptured) return false;
-  moduleDataCaptured = false;
+  if (moduleBufferLength == 0) return false;
+
+  // Copies data from the module buffer to moduleData[]
+  byte dataIndex = moduleBufferIndex;
+  for (byte i = 0; i < dscReadSize; i++) moduleData[i] = moduleBuffer[dataIndex][i];
+  moduleCmd = moduleBufferCmd[dataIndex];
+  moduleSubCmd = moduleBufferSubCmd[dataIndex];
+  moduleBitCount = moduleBufferBitCount[dataIndex];
+  moduleByteCount = moduleBufferByteCount[dataIndex];
+
+  #if defined(ESP32)
+  portENTER_CRITICAL(&timer1Mux);
+  #else
+  noInterrupts();
+  #endif
+
+  moduleBufferIndex++;
+  if (moduleBufferIndex >= dscModuleBufferSize) moduleBufferIndex = 0;
+  moduleBufferLength--;
+
+  #if defined(ESP32)
+  portEXIT_CRITICAL(&timer1Mux);
+  #else
+  interrupts();
+  #endif
 
   if (moduleBitCount < 8) return false;
 
-  // Determines if a keybus message is a response to a panel command
+  // Determines if a keybus message is a response to a panel query
   switch (moduleCmd) {
     case 0x11:
+    case 0x22:
     case 0x28:
+    case 0x33:
+    case 0x39:
+    case 0x41:
+    case 0x4C:
+    case 0x58:
     case 0xD5: queryResponse = true; break;
+    case 0xE6: {
+      switch (moduleSubCmd) {
+        case 0x08:
+        case 0x0A:
+        case 0x0C:
+        case 0x0E: queryResponse = true; break;
+        default: queryResponse = false; break;
+      }
+      break;
+    }
     default: queryResponse = false; break;
   }
 
+  // Tracks the keypad and zone expander slots that responded to the query
+  if (queryResponse) processModuleSlots();
+
+  // LCD keypad data entry
+  if (moduleCmd == 0x70) {
+    byte dataBytes[4];
+    for (byte i = 0; i < 4; i++) dataBytes[i] = moduleData[i + 2];
+    if (processLCDData(lcdEntry, dataBytes)) {
+      lcdEntryChanged = true;
+      if (!pauseStatus) statusChanged = true;
+    }
+  }
+
   return true;
 }
 
-// Sets up writes for a single key
-void dscKeybusInterface::write(const char receivedKey) {
+// Sets the state of a virtual zone expander zone and notifies the panel if the zone has changed
+bool dscKeybusInterface::setZone(byte zone, byte zoneState) {
+  if (zone < 1 || zoneState > DSC_ZONE_TAMPER || !virtualKeypad) return false;
 
-  // Blocks if a previous write is in progress
-  while(writeKeyPending || writeKeysPending) {
-    loop();
-    #if defined(ESP8266)
-    yield();
-    #endif
+  byte expander = (zone - 1) / 8;
+  if (expander == 0 || expander >= dscExpanders || !bitRead(virtualExpanders, expander)) return false;  // Expanders 1-3 are emulated
+
+  // Zones 1-4 are in byte 0 and zones 5-8 in byte 2, starting from bits 0-1
+  byte zoneIndex = (zone - 1) % 8;
+  byte zoneByte = (zoneIndex / 4) * 2;
+  byte zoneShift = (zoneIndex % 4) * 2;
+
+  #if defined(ESP32)
+  portENTER_CRITICAL(&timer1Mux);
+  #else
+  noInterrupts();
+  #endif
+
+  byte zoneData = (expanderData[expander][zoneByte] & ~(0x03 << zoneShift)) | (zoneState << zoneShift);
+  if (zoneData != expanderData[expander][zoneByte]) {
+    expanderData[expander][zoneByte] = zoneData;
+    setExpanderChecksum(expander);
+    bitSet(expanderNotify, expander);
   }
 
-  setWriteKey(receivedKey);
-}
+  #if defined(ESP32)
+  portEXIT_CRITICAL(&timer1Mux);
+  #else
+  interrupts();
+  #endif
 
+  return true;
+}
 
-// Sets up writes for multiple keys sent as a char array
-void dscKeybusInterface::write(const char *receivedKeys, bool blockingWrite) {
 
-  // Blocks if a previous write is in progress
-  while(writeKeyPending || writeKeysPending) {
-    loop();
-    #if defined(ESP8266)
-    yield();
-    #endif
-  }
+// Sets up writes for a single key
+byte dscKeybusInterface::write(const char receivedKey) {
+  char receivedKeys[2] = {receivedKey, '\0'};
+  return bufferKeys(receivedKeys, writePartition);
+}
 
-  writeKeysArray = receivedKeys;
 
-  if (writeKeysArray[0] != '\0') {
-    writeKeysPending = true;
-    writeReady = false;
-  }
+// Sets up writes for multiple keys sent as a char array
+byte dscKeybusInterface::write(const char *receivedKeys, bool blockingWrite) {
+  byte keysHandle = bufferKeys(receivedKeys, writePartition);
 
-  // Optionally blocks until the write is complete, necessary if the received keys char array is ephemeral
-  if (blockingWrite) {
-    while (writeKeysPending) {
-      writeKeys(writeKeysArray);
+  // Optionally blocks until the write is complete
+  if (blockingWrite && keysHandle != 0) {
+    while (!writeComplete(keysHandle)) {
       loop();
       #if defined(ESP8266)
       yield();
       #endif
     }
   }
-  else writeKeys(writeKeysArray);
+
+  return keysHandle;
 }
 
 
-// Writes multiple keys from a char array
-void dscKeybusInterface::writeKeys(const char *writeKeysArray) {
-  static byte writeCounter = 0;
-  if (!writeKeyPending && writeKeysPending && writeCounter < strlen(writeKeysArray)) {
-    if (writeKeysArray[writeCounter] != '\0') {
-      setWriteKey(writeKeysArray[writeCounter]);
-      writeCounter++;
-      if (writeKeysArray[writeCounter] == '\0') {
-        writeKeysPending = false;
-        writeCounter = 0;
+// Copies keys to the key buffer tagged with the write partition, returns a write handle or 0 if the keys do not fit.
+// The virtual keypad key '/' followed by a partition number sets writePartition and the partition of the remaining keys.
+byte dscKeybusInterface::bufferKeys(const char *receivedKeys, byte keyPartition) {
+  byte keyCount = 0;
+  bool partitionKey = setPartition;
+  for (byte i = 0; receivedKeys[i] != '\0'; i++) {
+    if (partitionKey) partitionKey = false;
+    else if (receivedKeys[i] == '/') partitionKey = true;
+    else keyCount++;
+    if (keyCount > dscKeyBufferSize - keyBufferLength) return 0;
+  }
+
+  writeHandle++;
+  if (writeHandle == 0) writeHandle = 1;
+
+  // Tracks the write timing in an unused ticket, or replaces the oldest completed ticket
+  if (keyCount > 0) {
+    byte ticketIndex = dscWriteTicketSize;
+    for (byte i = 0; i < dscWriteTicketSize; i++) {
+      if (writeTickets[i].handle == 0) {
+        ticketIndex = i;
+        break;
+      }
+      if (writeTickets[i].complete && (ticketIndex == dscWriteTicketSize || writeTickets[i].completeTime - writeTickets[ticketIndex].completeTime > 0x7FFFFFFF)) {
+        ticketIndex = i;
+      }
+    }
+    if (ticketIndex < dscWriteTicketSize) {
+      writeTickets[ticketIndex].handle = writeHandle;
+      writeTickets[ticketIndex].keyCount = keyCount;
+      writeTickets[ticketIndex].keysWritten = 0;
+      writeTickets[ticketIndex].queueTime = millis();
+      writeTickets[ticketIndex].startTime = 0;
+      writeTickets[ticketIndex].completeTime = 0;
+      writeTickets[ticketIndex].waitTime = 0;
+      writeTickets[ticketIndex].retries = 0;
+      writeTickets[ticketIndex].keysFailed = 0;
+      writeTickets[ticketIndex].complete = false;
+    }
+  }
+
+  for (byte i = 0; receivedKeys[i] != '\0'; i++) {
+    if (setPartition) {
+      setPartition = false;
+      if (receivedKeys[i] >= '1' && receivedKeys[i] <= '8') {
+        writePartition = receivedKeys[i] - 48;
+        keyPartition = writePartition;
       }
+      continue;
+    }
+    if (receivedKeys[i] == '/') {
+      setPartition = true;
+      continue;
     }
+
+    byte keyPosition = keyBufferIndex + keyBufferLength;
+    if (keyPosition >= dscKeyBufferSize) keyPosition -= dscKeyBufferSize;
+    keyBuffer[keyPosition] = receivedKeys[i];
+    keyBufferPartition[keyPosition] = keyPartition;
+    keyBufferHandle[keyPosition] = writeHandle;
+    keyBufferLength++;
+  }
+
+  if (keyBufferLength > 0) {
+    writeReady = false;
+    writeKeys();
   }
+  return writeHandle;
 }
 
 
-// Specifies the key value to be written by dscClockInterrupt() and selects the write partition.  This includes a 500ms
-// delay after alarm keys to resolve errors when additional keys are sent immediately after alarm keys.
-void dscKeybusInterface::setWriteKey(const char receivedKey) {
-  static unsigned long previousTime;
-  static bool setPartition;
+// Checks if all keys from a write handle have been written
+bool dscKeybusInterface::writeComplete(byte checkedHandle) {
+  if (checkedHandle == 0) return false;
+  for (byte writeSlot = 0; writeSlot <= dscWriteSlots; writeSlot++) {
+    if (writeKeyPending[writeSlot] && writeKeyHandle[writeSlot] == checkedHandle) return false;
+  }
 
-  // Sets the write partition if set by virtual keypad key '/'
-  if (setPartition) {
-    setPartition = false;
-    if (receivedKey >= '1' && receivedKey <= '8') {
-      writePartition = receivedKey - 48;
-    }
-    return;
+  byte keyPosition = keyBufferIndex;
+  for (byte i = 0; i < keyBufferLength; i++) {
+    if (keyBuffer[keyPosition] != 0 && keyBufferHandle[keyPosition] == checkedHandle) return false;
+    keyPosition++;
+    if (keyPosition >= dscKeyBufferSize) keyPosition = 0;
   }
+  return true;
+}
 
-  // Sets the binary to write for virtual keypad keys
-  if (!writeKeyPending && (millis() - previousTime > 500 || millis() <= 500)) {
-    bool validKey = true;
 
-    // Skips writing to disabled partitions or partitions not specified in dscKeybusInterface.h
-    if (disabled[writePartition - 1] || dscPartitions < writePartition) {
-      switch (receivedKey) {
-        case '/': setPartition = true; validKey = false; break;
+// Writes keys from the key buffer, called by loop() and write().  Keys for different partition slots can be set
+// together to be written in the same status command, while keys for each partition are kept in order.
+void dscKeybusInterface::writeKeys() {
+  byte waitingPartitions = 0;
+  byte keyPosition = keyBufferIndex;
+  for (byte i = 0; i < keyBufferLength; i++) {
+    if (keyBuffer[keyPosition] != 0) {
+      byte partitionBit = 1 << ((keyBufferPartition[keyPosition] - 1) & 0x07);
+      bool alarmKey = writeAlarmKey(keyBuffer[keyPosition]);  // Alarm keys are set ahead of other keys in the partition
+      if ((alarmKey || !(waitingPartitions & partitionBit)) && setWriteKey(keyBuffer[keyPosition], keyBufferPartition[keyPosition], keyBufferHandle[keyPosition])) {
+        keyBuffer[keyPosition] = 0;  // Marks the key as written
       }
-      return;
+      else if (!alarmKey) waitingPartitions |= partitionBit;
     }
+    keyPosition++;
+    if (keyPosition >= dscKeyBufferSize) keyPosition = 0;
+  }
 
-    // Sets binary for virtual keypad keys
-    else {
-      switch (receivedKey) {
-        case '/': setPartition = true; validKey = false; break;
-        case '0': writeKey = 0x00; break;
-        case '1': writeKey = 0x05; break;
-        case '2': writeKey = 0x0A; break;
-        case '3': writeKey = 0x0F; break;
-        case '4': writeKey = 0x11; break;
-        case '5': writeKey = 0x16; break;
-        case '6': writeKey = 0x1B; break;
-        case '7': writeKey = 0x1C; break;
-        case '8': writeKey = 0x22; break;
-        case '9': writeKey = 0x27; break;
-        case '*': writeKey = 0x28; if (status[writePartition - 1] < 0x9E) starKeyCheck = true; break;
-        case '#': writeKey = 0x2D; break;
-        case 'f': case 'F': writeKey = 0xBB; writeAlarm = true; break;                           // Keypad fire alarm
-        case 'b': case 'B': writeKey = 0x82; break;                                              // Enter event buffer
-        case '>': writeKey = 0x87; break;                                                        // Event buffer right arrow
-        case '<': writeKey = 0x88; break;                                                        // Event buffer left arrow
-        case 'l': case 'L': writeKey = 0xA5; break;                                              // LCD keypad data request
-        case 's': case 'S': writeKey = 0xAF; writeAccessCode[writePartition - 1] = true; break;  // Arm stay
-        case 'w': case 'W': writeKey = 0xB1; writeAccessCode[writePartition - 1] = true; break;  // Arm away
-        case 'n': case 'N': writeKey = 0xB6; writeAccessCode[writePartition - 1] = true; break;  // Arm with no entry delay (night arm)
-        case 'a': case 'A': writeKey = 0xDD; writeAlarm = true; break;                           // Keypad auxiliary alarm
-        case 'c': case 'C': writeKey = 0xBB; break;                                              // Door chime
-        case 'r': case 'R': writeKey = 0xDA; break;                                              // Reset
-        case 'p': case 'P': writeKey = 0xEE; writeAlarm = true; break;                           // Keypad panic alarm
-        case 'x': case 'X': writeKey = 0xE1; break;                                              // Exit
-        case '[': writeKey = 0xD5; writeAccessCode[writePartition - 1] = true; break;            // Command output 1
-        case ']': writeKey = 0xDA; writeAccessCode[writePartition - 1] = true; break;            // Command output 2
-        case '{': writeKey = 0x70; writeAccessCode[writePartition - 1] = true; break;            // Command output 3
-        case '}': writeKey = 0xEC; writeAccessCode[writePartition - 1] = true; break;            // Command output 4
-        default: {
-          validKey = false;
-          break;
-        }
-      }
+  // Removes written keys from the start of the key buffer
+  while (keyBufferLength > 0 && keyBuffer[keyBufferIndex] == 0) {
+    keyBufferIndex++;
+    if (keyBufferIndex >= dscKeyBufferSize) keyBufferIndex = 0;
+    keyBufferLength--;
+  }
+}
+
+
+// Checks write slots for keys written by dscClockInterrupt(), called by loop()
+void dscKeybusInterface::processWriteTickets() {
+
+  // Releases the '*' key wait if the panel has not acknowledged the key
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (starKeyWait[partitionIndex] && millis() - writeEndTime[partitionIndex % dscWriteSlots] > 2000) processStarKeyWait(partitionIndex);
+  }
+
+  for (byte writeSlot = 0; writeSlot <= dscWriteSlots; writeSlot++) {
+    if (writeSlotActive[writeSlot] && !writeKeyPending[writeSlot]) {
+      writeSlotActive[writeSlot] = false;
+      processWriteKey(writeKeyHandle[writeSlot], writeSlot);
     }
+  }
+}
 
-    // Sets the writing position in dscClockInterrupt() for the currently set partition
-    switch (writePartition) {
-      case 1:
-      case 5: {
-        writeByte = 2;
-        writeBit = 9;
-        break;
-      }
-      case 2:
-      case 6: {
-        writeByte = 3;
-        writeBit = 17;
-        break;
-      }
-      case 3:
-      case 7: {
-        writeByte = 8;
-        writeBit = 57;
-        break;
-      }
-      case 4:
-      case 8: {
-        writeByte = 9;
-        writeBit = 65;
-        break;
-      }
-      default: {
-        writeByte = 2;
-        writeBit = 9;
-        break;
+
+// Updates the write ticket for a written key - keys skipped without writing to the Keybus use writeSlot 0xFF
+void dscKeybusInterface::processWriteKey(byte keyHandle, byte writeSlot) {
+  for (byte i = 0; i < dscWriteTicketSize; i++) {
+    if (writeTickets[i].handle != keyHandle || writeTickets[i].complete) continue;
+
+    if (writeSlot <= dscWriteSlots) {
+      #if defined(ESP32)
+      portENTER_CRITICAL(&timer1Mux);
+      #else
+      noInterrupts();
+      #endif
+
+      if (writeTickets[i].startTime == 0) writeTickets[i].startTime = writeStartTime[writeSlot];
+      writeTickets[i].completeTime = writeEndTime[writeSlot];
+
+      #if defined(ESP32)
+      portEXIT_CRITICAL(&timer1Mux);
+      #else
+      interrupts();
+      #endif
+
+      writeTickets[i].waitTime += writeWaitTime[writeSlot];
+      writeTickets[i].retries += writeRetries[writeSlot];
+      if (writeFailed[writeSlot]) writeTickets[i].keysFailed++;
+      writeWaitTime[writeSlot] = 0;
+    }
+
+    writeTickets[i].keysWritten++;
+    if (writeTickets[i].keysWritten >= writeTickets[i].keyCount) {
+      if (writeTickets[i].completeTime == 0) writeTickets[i].completeTime = millis();
+      writeTickets[i].complete = true;
+    }
+    return;
+  }
+}
+
+
+// Copies the oldest completed write ticket to writeTicket
+bool dscKeybusInterface::handleWriteTicket() {
+  byte ticketIndex = dscWriteTicketSize;
+  for (byte i = 0; i < dscWriteTicketSize; i++) {
+    if (writeTickets[i].handle != 0 && writeTickets[i].complete) {
+      if (ticketIndex == dscWriteTicketSize || writeTickets[ticketIndex].completeTime - writeTickets[i].completeTime < 0x80000000) {
+        ticketIndex = i;
       }
     }
+  }
+  if (ticketIndex == dscWriteTicketSize) return false;
+
+  writeTicket = writeTickets[ticketIndex];
+  writeTickets[ticketIndex].handle = 0;
+  return true;
+}
+
+
+// Checks if a key is pending in any write slot, including the alarm key slot
+bool dscKeybusInterface::writeKeysPending() {
+  for (byte writeSlot = 0; writeSlot <= dscWriteSlots; writeSlot++) {
+    if (writeKeyPending[writeSlot]) return true;
+  }
+  return false;
+}
+
 
-    if (writeAlarm) previousTime = millis();  // Sets a marker to time writes after keypad alarm keys
-    if (validKey) {
-      writeKeyPending = true;                 // Sets a flag indicating that a write is pending, cleared by dscClockInterrupt()
-      writeReady = false;
+// Specifies the key value to be written by dscClockInterrupt() in the write slot of the key partition.  Alarm keys use
+// a separate write slot that is written at the start of the next command, ahead of keys pending in the partition slots.
+// Keys after alarm keys wait until the panel verifies the alarm key with command 0x1C to resolve errors when additional
+// keys are sent immediately after alarm keys, with a 500ms delay if the verification is not seen.
+//
+// Returns false if the key cannot be set yet and should be retried.
+bool dscKeybusInterface::setWriteKey(const char receivedKey, byte keyPartition, byte keyHandle) {
+  // Skips writing to disabled partitions or partitions not specified in dscKeybusInterface.h
+  if (keyPartition == 0 || dscPartitions < keyPartition || disabled[keyPartition - 1]) {
+    processWriteKey(keyHandle, 0xFF);
+    return true;
+  }
+
+  // Partitions 1-4 and 5-8 use the same write slots in status commands 0x05 and 0x1B
+  byte writeSlot = (keyPartition - 1) % dscWriteSlots;
+  if (writeAlarmKey(receivedKey)) writeSlot = dscWriteSlots;
+  if (writeKeyPending[writeSlot] || writeAlarm || (!writeAlarmAck && millis() - previousWriteKeyTime <= 500 && millis() > 500)) return false;
+
+  // Sets binary for virtual keypad keys
+  bool validKey = true;
+  switch (receivedKey) {
+    case '0': writeKey[writeSlot] = 0x00; break;
+    case '1': writeKey[writeSlot] = 0x05; break;
+    case '2': writeKey[writeSlot] = 0x0A; break;
+    case '3': writeKey[writeSlot] = 0x0F; break;
+    case '4': writeKey[writeSlot] = 0x11; break;
+    case '5': writeKey[writeSlot] = 0x16; break;
+    case '6': writeKey[writeSlot] = 0x1B; break;
+    case '7': writeKey[writeSlot] = 0x1C; break;
+    case '8': writeKey[writeSlot] = 0x22; break;
+    case '9': writeKey[writeSlot] = 0x27; break;
+    case '*': writeKey[writeSlot] = 0x28; if (status[keyPartition - 1] < 0x9E) starKeyCheck[writeSlot] = true; break;
+    case '#': writeKey[writeSlot] = 0x2D; break;
+    case 'f': case 'F': writeKey[writeSlot] = 0xBB; writeAlarm = true; break;                           // Keypad fire alarm
+    case 'b': case 'B': writeKey[writeSlot] = 0x82; break;                                              // Enter event buffer
+    case '>': writeKey[writeSlot] = 0x87; break;                                                        // Event buffer right arrow
+    case '<': writeKey[writeSlot] = 0x88; break;                                                        // Event buffer left arrow
+    case 'l': case 'L': writeKey[writeSlot] = 0xA5; break;                                              // LCD keypad data request
+    case 's': case 'S': writeKey[writeSlot] = 0xAF; writeAccessCode[keyPartition - 1] = true; break;  // Arm stay
+    case 'w': case 'W': writeKey[writeSlot] = 0xB1; writeAccessCode[keyPartition - 1] = true; break;  // Arm away
+    case 'n': case 'N': writeKey[writeSlot] = 0xB6; writeAccessCode[keyPartition - 1] = true; break;  // Arm with no entry delay (night arm)
+    case 'a': case 'A': writeKey[writeSlot] = 0xDD; writeAlarm = true; break;                           // Keypad auxiliary alarm
+    case 'c': case 'C': writeKey[writeSlot] = 0xBB; break;                                              // Door chime
+    case 'r': case 'R': writeKey[writeSlot] = 0xDA; break;                                              // Reset
+    case 'p': case 'P': writeKey[writeSlot] = 0xEE; writeAlarm = true; break;                           // Keypad panic alarm
+    case 'x': case 'X': writeKey[writeSlot] = 0xE1; break;                                              // Exit
+    case '[': writeKey[writeSlot] = 0xD5; writeAccessCode[keyPartition - 1] = true; break;            // Command output 1
+    case ']': writeKey[writeSlot] = 0xDA; writeAccessCode[keyPartition - 1] = true; break;            // Command output 2
+    case '{': writeKey[writeSlot] = 0x70; writeAccessCode[keyPartition - 1] = true; break;            // Command output 3
+    case '}': writeKey[writeSlot] = 0xEC; writeAccessCode[keyPartition - 1] = true; break;            // Command output 4
+    default: {
+      validKey = false;
+      break;
     }
   }
+
+  if (writeAlarm) {
+    previousWriteKeyTime = millis();  // Sets a marker to time writes after keypad alarm keys
+    writeAlarmAck = false;
+  }
+  if (validKey) {
+
+    // Sets the write plan used by dscClockInterrupt(): the status command and bit for the key partition slot
+    if (writeSlot < dscWriteSlots) {
+      if (keyPartition <= 4) writePlanCmd[writeSlot] = 0x05;
+      else writePlanCmd[writeSlot] = 0x1B;
+      if (writeSlot < 2) writePlanBit[writeSlot] = (writeSlot * 8) + 9;  // Bits 9, 17 after the stop bit in byte 1
+      else writePlanBit[writeSlot] = (writeSlot * 8) + 41;               // Bits 57, 65 after the zone lights bytes
+    }
+
+    writeKeyPartition[writeSlot] = keyPartition;
+    writeKeyHandle[writeSlot] = keyHandle;
+    writeRetries[writeSlot] = 0;
+    writeFailed[writeSlot] = false;
+    writeSlotActive[writeSlot] = true;
+    writeKeyPending[writeSlot] = true;      // Sets a flag indicating that a write is pending, cleared by dscClockInterrupt()
+    writeReady = false;
+  }
+  else processWriteKey(keyHandle, 0xFF);
+  return true;
 }
 
 
@@ -438,6 +980,58 @@ bool IRAM_ATTR dscKeybusInterface::redundantPanelData(byte previousCmd[], volati
 }
 
 
+// Checks for keypad fire, auxiliary, and panic alarm keys
+bool dscKeybusInterface::writeAlarmKey(const char receivedKey) {
+  switch (receivedKey) {
+    case 'f': case 'F':
+    case 'a': case 'A':
+    case 'p': case 'P': return true;
+    default: return false;
+  }
+}
+
+
+// Selects the first write slot from startSlot with a key pending for the current status command, so that
+// dscClockInterrupt() only compares the bit count with the planned start bit
+#if defined(__AVR__)
+void dscKeybusInterface::setWritePlan(byte startSlot) {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscKeybusInterface::setWritePlan(byte startSlot) {
+#elif defined(ESP32)
+void IRAM_ATTR dscKeybusInterface::setWritePlan(byte startSlot) {
+#endif
+
+  for (byte writeSlot = startSlot; writeSlot < dscWriteSlots; writeSlot++) {
+    if (writeKeyPending[writeSlot] && writePlanCmd[writeSlot] == statusCmd && !starKeyWait[writeKeyPartition[writeSlot] - 1]) {
+      writePlanStart = writePlanBit[writeSlot];
+      writePlanSlot = writeSlot;
+      return;
+    }
+  }
+  writePlanSlot = dscWriteSlots;
+}
+
+
+// Sets the zone expander response checksum for queries 0x28, 0x33, 0x39: the sum of the zone data nibbles as sent on
+// the Keybus (inverted) in bits 4-7, with bits 0-3 set.  This matches the 0x28 capture in dscKeybusPrintData.cpp, but
+// not the 0x22 and 0xE6.08 captures (0xE6 zone data C3 CF FF FF is answered with 0xAF, not 0x2F).
+#if defined(__AVR__)
+void dscKeybusInterface::setExpanderChecksum(byte expander) {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscKeybusInterface::setExpanderChecksum(byte expander) {
+#elif defined(ESP32)
+void IRAM_ATTR dscKeybusInterface::setExpanderChecksum(byte expander) {
+#endif
+
+  byte checksum = 0;
+  for (byte zoneByte = 0; zoneByte < 4; zoneByte++) {
+    byte zoneData = ~expanderData[expander][zoneByte];
+    checksum += (zoneData >> 4) + (zoneData & 0x0F);
+  }
+  expanderData[expander][4] = (checksum << 4) | 0x0F;
+}
+
+
 bool dscKeybusInterface::validCRC() {
   byte byteCount = (panelBitCount - 1) / 8;
   int dataSum = 0;
@@ -449,6 +1043,41 @@ bool dscKeybusInterface::validCRC() {
 }
 
 
+// Interrupt functions for each interface, calling the interface running on the Keybus pins and timer of the interrupt
+#if defined(__AVR__)
+void dscKeybusInterface::dscClockInterrupt0() {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscKeybusInterface::dscClockInterrupt0() {
+#elif defined(ESP32)
+void IRAM_ATTR dscKeybusInterface::dscClockInterrupt0() {
+#endif
+  instances[0]->dscClockInterrupt();
+}
+
+
+#if defined(__AVR__)
+void dscKeybusInterface::dscDataInterrupt0() {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscKeybusInterface::dscDataInterrupt0() {
+#elif defined(ESP32)
+void IRAM_ATTR dscKeybusInterface::dscDataInterrupt0() {
+#endif
+  instances[0]->dscDataInterrupt();
+}
+
+
+#if defined(ESP32)
+void IRAM_ATTR dscKeybusInterface::dscClockInterrupt1() {
+  instances[1]->dscClockInterrupt();
+}
+
+
+void IRAM_ATTR dscKeybusInterface::dscDataInterrupt1() {
+  instances[1]->dscDataInterrupt();
+}
+#endif
+
+
 // Called as an interrupt when the DSC clock changes to write data for virtual keypad and setup timers to read
 // data after an interval.
 #if defined(__AVR__)
@@ -478,9 +1107,6 @@ void IRAM_ATTR dscKeybusInterface::dscClockInterrupt() {
   portENTER_CRITICAL(&timer1Mux);
   #endif
 
-  static unsigned long previousClockHighTime;
-  static bool skipData = false;
-
   // Panel sends data while the clock is high
   if (digitalRead(dscClockPin) == HIGH) {
     if (virtualKeypad) digitalWrite(dscWritePin, LOW);  // Restores the data line after a virtual keypad write
@@ -499,9 +1125,6 @@ void IRAM_ATTR dscKeybusInterface::dscClockInterrupt() {
       // rate, so they are always skipped.  Checking is required in the ISR to prevent flooding the buffer.
       if (isrPanelBitTotal < 8) skipData = true;
       else switch (isrPanelData[0]) {
-        static byte previousCmd05[dscReadSize];
-        static byte previousCmd1B[dscReadSize];
-
         case 0x05:  // Status: partitions 1-4
           if (redundantPanelData(previousCmd05, isrPanelData, isrPanelByteCount)) skipData = true;
           break;
@@ -511,8 +1134,15 @@ void IRAM_ATTR dscKeybusInterface::dscClockInterrupt() {
           break;
       }
 
-      // Stores new panel data in the panel buffer
+      // Checks that the repeated alarm key was written during the 0x1C alarm key verification command - keys after the
+      // alarm key otherwise wait 500ms in setWriteKey()
       currentCmd = isrPanelData[0];
+      if (writeAlarmRepeated) {
+        writeAlarmRepeated = false;
+        if (currentCmd == 0x1C) writeAlarmAck = true;  // The panel has verified the alarm key, the next key can be written
+      }
+
+      // Stores new panel data in the panel buffer
       if (panelBufferLength == dscBufferSize) bufferOverflow = true;
       else if (!skipData && panelBufferLength < dscBufferSize) {
         for (byte i = 0; i < dscReadSize; i++) panelBuffer[panelBufferLength][i] = isrPanelData[i];
@@ -523,15 +1153,20 @@ void IRAM_ATTR dscKeybusInterface::dscClockInterrupt() {
 
       if (processModuleData) {
 
-        // Stores new keypad and module data - this data is not buffered
+        // Stores new keypad and module data in the module buffer with the panel command
         if (moduleDataDetected) {
-          moduleCmd = isrPanelData[0];
-          moduleSubCmd = isrPanelData[2];
           moduleDataDetected = false;
-          moduleDataCaptured = true;  // Sets a flag for handleModule()
-          for (byte i = 0; i < dscReadSize; i++) moduleData[i] = isrModuleData[i];
-          moduleBitCount = isrPanelBitTotal;
-          moduleByteCount = isrPanelByteCount;
+          if (moduleBufferLength == dscModuleBufferSize) bufferOverflow = true;
+          else if (isrPanelBitTotal >= 8) {
+            byte moduleIndex = moduleBufferIndex + moduleBufferLength;
+            if (moduleIndex >= dscModuleBufferSize) moduleIndex -= dscModuleBufferSize;
+            for (byte i = 0; i < dscReadSize; i++) moduleBuffer[moduleIndex][i] = isrModuleData[i];
+            moduleBufferCmd[moduleIndex] = isrPanelData[0];
+            moduleBufferSubCmd[moduleIndex] = isrPanelData[2];
+            moduleBufferBitCount[moduleIndex] = isrPanelBitTotal;
+            moduleBufferByteCount[moduleIndex] = isrPanelByteCount;
+            moduleBufferLength++;
+          }
         }
 
         // Resets the keypad and module capture data
@@ -549,63 +1184,124 @@ void IRAM_ATTR dscKeybusInterface::dscClockInterrupt() {
     // Virtual keypad
     if (virtualKeypad) {
 
-      static bool writeStart = false;
-      static bool writeRepeat = false;
-      static bool writeCmd = false;
-
-      if (writePartition <= 4 && statusCmd == 0x05) writeCmd = true;
-      else if (writePartition >= 5 && statusCmd == 0x1B) writeCmd = true;
-      else writeCmd = false;
+      // Selects the alarm key slot for the command at the start of the command, so a key being written in a partition
+      // slot is completed before the alarm key is written.  Keys in the partition slots resume after the alarm key.
+      if (isrPanelBitTotal == 0) writeAlarmCmd = (writeAlarm && writeKeyPending[dscWriteSlots]) || writeRepeat;
 
       // Writes a F/A/P alarm key and repeats the key on the next immediate command from the panel (0x1C verification)
-      if ((writeAlarm && writeKeyPending) || writeRepeat) {
+      if (writeAlarmCmd) {
 
-        // Writes the first bit by shifting the alarm key data right 7 bits and checking bit 0
+        // Starts the alarm key at bit 0 of the command
         if (isrPanelBitTotal == 0) {
-          if (!((writeKey >> 7) & 0x01)) {
-            digitalWrite(dscWritePin, HIGH);
-          }
+          writeBits = writeKey[dscWriteSlots];
           writeStart = true;  // Resolves a timing issue where some writes do not begin at the correct bit
+          if (!writeRepeat) writeStartTime[dscWriteSlots] = millis();
         }
 
-        // Writes the remaining alarm key data
-        else if (writeStart && isrPanelBitTotal <= 7) {
-          if (!((writeKey >> (7 - isrPanelBitTotal)) & 0x01)) digitalWrite(dscWritePin, HIGH);
+        // Writes the alarm key data from the most significant bit
+        if (writeStart && isrPanelBitTotal <= 7) {
+          if (!(writeBits & 0x80)) digitalWrite(dscWritePin, HIGH);
+          writeBits <<= 1;
 
           // Resets counters when the write is complete
           if (isrPanelBitTotal == 7) {
-            writeKeyPending = false;
+            if (!writeRepeat) writeEndTime[dscWriteSlots] = millis();
+            writeKeyPending[dscWriteSlots] = false;
             writeStart = false;
             writeAlarm = false;
+            writeAlarmCmd = false;
 
             // Sets up a repeated write for alarm keys
             if (!writeRepeat) writeRepeat = true;
-            else writeRepeat = false;
+            else {
+              writeRepeat = false;
+              writeAlarmRepeated = true;
+            }
           }
         }
       }
 
-      // Writes a regular key unless waiting for a response to the '*' key or the panel is sending a query command
-      else if (writeKeyPending && !starKeyWait[writePartition - 1] && isrPanelByteCount == writeByte && writeCmd) {
+      // Writes regular keys in the partition slots of the status command, as planned by setWritePlan()
+      else if (writePlanSlot < dscWriteSlots) {
+        byte writeSlot = writePlanSlot;
 
-        // Writes the first bit by shifting the key data right 7 bits and checking bit 0
-        if (isrPanelBitTotal == writeBit) {
-          if (!((writeKey >> 7) & 0x01)) digitalWrite(dscWritePin, HIGH);
+        // Starts the key at the planned bit
+        if (isrPanelBitTotal == writePlanStart) {
+          writeBits = writeKey[writeSlot];
           writeStart = true;  // Resolves a timing issue where some writes do not begin at the correct bit
+          writeCollision = false;
+          if (writeRetries[writeSlot] == 0) writeStartTime[writeSlot] = millis();
         }
 
-        // Writes the remaining key data
-        else if (writeStart && isrPanelBitTotal > writeBit && isrPanelBitTotal <= writeBit + 7) {
-          if (!((writeKey >> (7 - isrPanelBitCount)) & 0x01)) digitalWrite(dscWritePin, HIGH);
-
-          // Resets counters when the write is complete
-          if (isrPanelBitTotal == writeBit + 7) {
-            if (starKeyCheck) starKeyWait[writePartition - 1] = true;  // Handles waiting until the panel is ready after pressing '*'
-            else writeKeyPending = false;
+        // Writes the key data from the most significant bit
+        if (writeStart && isrPanelBitTotal >= writePlanStart) {
+          writeVerifyLevel = writeBits & 0x80;
+          if (!writeVerifyLevel) digitalWrite(dscWritePin, HIGH);
+          writeBits <<= 1;
+          writeVerify = true;
+
+          // Sets dscDataInterrupt() to complete the write after reading back the last bit and plans the next slot
+          if (isrPanelBitTotal == writePlanStart + 7) {
+            writeEndTime[writeSlot] = millis();
+            writeVerifySlot = writeSlot;
+            writeVerifyEnd = true;
             writeStart = false;
+            setWritePlan(writeSlot + 1);
           }
         }
       }
+
+      // Virtual zone expanders
+      if (virtualExpanders) {
+        // Selects the zone isrExpander for queries 0x28, 0x33, 0x39.  Only these responses match the checksum of
+        // setExpanderChecksum() - the 0x22 query for expander 0 and the 0xE6.08-0E queries for expanders 4-7 use a
+        // different checksum and are not answered.
+        if (isrPanelBitTotal == 8) {
+          switch (isrPanelData[0]) {
+            case 0x28: isrExpander = 1; break;
+            case 0x33: isrExpander = 2; break;
+            case 0x39: isrExpander = 3; break;
+            default: isrExpander = dscExpanders; break;
+          }
+          if (isrExpander < dscExpanders && !bitRead(virtualExpanders, isrExpander)) isrExpander = dscExpanders;
+        }
+
+        // Writes the zone isrExpander response from the most significant bit
+        if (isrExpander < dscExpanders) {
+          if (isrPanelBitTotal >= 9) {
+            byte responseBit = isrPanelBitTotal - 9;
+            if (!bitRead(expanderData[isrExpander][responseBit >> 3], 7 - (responseBit & 0x07))) digitalWrite(dscWritePin, HIGH);
+
+            // Stores the zones sent as the previous zone states for the next response
+            if (responseBit == 39) {
+              expanderData[isrExpander][1] = expanderData[isrExpander][0];
+              expanderData[isrExpander][3] = expanderData[isrExpander][2];
+              setExpanderChecksum(isrExpander);
+              bitClear(expanderNotify, isrExpander);
+              isrExpander = dscExpanders;
+            }
+          }
+        }
+
+        // Writes zone expander notifications during the status command: byte 4 bits 6-4 for expanders 1-3
+        else if (statusCmd == 0x05 && expanderNotify) {
+          if (isrPanelBitTotal >= 26 && isrPanelBitTotal <= 28) {
+            if (bitRead(expanderNotify, isrPanelBitTotal - 25)) digitalWrite(dscWritePin, HIGH);
+          }
+        }
+
+        // Responds to the 0x11 module supervision query in the zone expander slots, see printModule_0x11()
+        else if (isrPanelData[0] == 0x11 && isrPanelBitTotal >= 25) {
+          byte expanderSlot = 0;
+          if (keybusVersion1) {
+            if (isrPanelBitTotal <= 36) expanderSlot = ((isrPanelBitTotal - 25) >> 2) + 1;  // Slots 1-3, 4 bits per slot
+          }
+          else {
+            if (isrPanelBitTotal <= 30) expanderSlot = ((isrPanelBitTotal - 25) >> 1) + 1;  // Slots 1-3, 2 bits per slot
+          }
+          if (expanderSlot && bitRead(virtualExpanders, expanderSlot)) digitalWrite(dscWritePin, HIGH);
+        }
+      }
     }
   }
   #if defined(ESP32)
@@ -646,6 +1342,7 @@ void IRAM_ATTR dscKeybusInterface::dscDataInterrupt() {
           case 0x1B: statusCmd = 0x1B; break;
           default: statusCmd = 0; break;
         }
+        if (virtualKeypad) setWritePlan(0);
       }
 
       // Stores the stop bit by itself in byte 1 - this aligns the Keybus bytes with panelData[] bytes
@@ -672,8 +1369,31 @@ void IRAM_ATTR dscKeybusInterface::dscDataInterrupt() {
   // Keypads and modules send data while the clock is low
   else {
 
-    // Keypad and module data is not buffered and skipped if the panel data buffer is filling
-    if (processModuleData && isrPanelByteCount < dscReadSize && panelBufferLength <= 1) {
+    // Reads back virtual keypad data - a bit written as 1 (data line released) that reads as 0 indicates that another
+    // keypad was sending data at the same time
+    if (writeVerify) {
+      writeVerify = false;
+      if (writeVerifyLevel && digitalRead(dscReadPin) == LOW) writeCollision = true;
+
+      // Completes the write, or rewrites the key during the next status command after a collision
+      if (writeVerifyEnd) {
+        writeVerifyEnd = false;
+        byte writeSlot = writeVerifySlot;
+        if (writeCollision && writeRetries[writeSlot] < writeRetryLimit) writeRetries[writeSlot]++;
+        else {
+          if (writeCollision) writeFailed[writeSlot] = true;
+          if (starKeyCheck[writeSlot] && !writeFailed[writeSlot]) starKeyWait[writeKeyPartition[writeSlot] - 1] = true;  // Handles waiting until the panel is ready after pressing '*'
+          else {
+            starKeyCheck[writeSlot] = false;
+            writeKeyPending[writeSlot] = false;
+          }
+        }
+        writeCollision = false;
+      }
+    }
+
+    // Keypad and module data is captured independently of the panel data buffer
+    if (processModuleData && isrPanelByteCount < dscReadSize) {
 
       // Data is captured in each byte by shifting left by 1 bit and writing to bit 0
       if (isrPanelBitCount < 8) {
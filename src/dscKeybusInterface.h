@@ -20,9 +20,13 @@
 #ifndef dscKeybusInterface_h
 #define dscKeybusInterface_h
 
+#if defined dscAutoSeries && !defined(ESP8266) && !defined(ESP32)
+#error "dscAutoSeries requires esp8266 or esp32"
+#endif
 
-// DSC Classic Series
-#if defined dscClassicSeries
+
+// DSC Classic Series - with dscAutoSeries, both the Classic series and PowerSeries interfaces are built
+#if defined dscClassicSeries || defined dscAutoSeries
 #include "dscClassic.h"
 
 byte dscClassicInterface::dscClockPin;
@@ -35,32 +39,33 @@ byte dscClassicInterface::writeByte;
 byte dscClassicInterface::writeBit;
 bool dscClassicInterface::virtualKeypad;
 bool dscClassicInterface::processModuleData;
-byte dscClassicInterface::panelData[dscReadSize];
-byte dscClassicInterface::pc16Data[dscReadSize];
+byte dscClassicInterface::panelData[dscClassicReadSize];
+byte dscClassicInterface::pc16Data[dscClassicReadSize];
 byte dscClassicInterface::panelByteCount;
 byte dscClassicInterface::panelBitCount;
 volatile bool dscClassicInterface::writeKeyPending;
 volatile bool dscClassicInterface::writeKeyWait;
-volatile byte dscClassicInterface::moduleData[dscReadSize];
+volatile byte dscClassicInterface::moduleData[dscClassicReadSize];
 volatile bool dscClassicInterface::moduleDataCaptured;
 volatile byte dscClassicInterface::moduleByteCount;
 volatile byte dscClassicInterface::moduleBitCount;
 volatile bool dscClassicInterface::writeAlarm;
+volatile byte dscClassicInterface::writeAlarmBit;
 volatile bool dscClassicInterface::starKeyDetected;
 volatile bool dscClassicInterface::starKeyCheck;
 volatile bool dscClassicInterface::starKeyWait;
 volatile bool dscClassicInterface::bufferOverflow;
 volatile byte dscClassicInterface::panelBufferLength;
-volatile byte dscClassicInterface::panelBuffer[dscBufferSize][dscReadSize];
-volatile byte dscClassicInterface::pc16Buffer[dscBufferSize][dscReadSize];
-volatile byte dscClassicInterface::panelBufferBitCount[dscBufferSize];
-volatile byte dscClassicInterface::panelBufferByteCount[dscBufferSize];
-volatile byte dscClassicInterface::isrPanelData[dscReadSize];
-volatile byte dscClassicInterface::isrPC16Data[dscReadSize];
+volatile byte dscClassicInterface::panelBuffer[dscClassicBufferSize][dscClassicReadSize];
+volatile byte dscClassicInterface::pc16Buffer[dscClassicBufferSize][dscClassicReadSize];
+volatile byte dscClassicInterface::panelBufferBitCount[dscClassicBufferSize];
+volatile byte dscClassicInterface::panelBufferByteCount[dscClassicBufferSize];
+volatile byte dscClassicInterface::isrPanelData[dscClassicReadSize];
+volatile byte dscClassicInterface::isrPC16Data[dscClassicReadSize];
 volatile byte dscClassicInterface::isrPanelByteCount;
 volatile byte dscClassicInterface::isrPanelBitCount;
 volatile byte dscClassicInterface::isrPanelBitTotal;
-volatile byte dscClassicInterface::isrModuleData[dscReadSize];
+volatile byte dscClassicInterface::isrModuleData[dscClassicReadSize];
 volatile byte dscClassicInterface::isrModuleByteCount;
 volatile byte dscClassicInterface::isrModuleBitCount;
 volatile byte dscClassicInterface::isrModuleBitTotal;
@@ -69,7 +74,6 @@ volatile bool dscClassicInterface::readyLight;
 volatile bool dscClassicInterface::lightBlink;
 volatile unsigned long dscClassicInterface::clockHighTime;
 volatile unsigned long dscClassicInterface::keybusTime;
-volatile unsigned long dscClassicInterface::writeCompleteTime;
 
 // Interrupt function called after 250us by dscClockInterrupt() using AVR Timer1, disables the timer and calls
 // dscDataInterrupt() to read the data line
@@ -79,10 +83,11 @@ ISR(TIMER1_OVF_vect) {
   dscClassicInterface::dscDataInterrupt();
 }
 #endif  // __AVR__
+#endif  // dscClassicSeries, dscAutoSeries
 
 
 // DSC Keypad Interface
-#elif defined dscKeypad
+#if defined dscKeypad
 #include "dscKeypad.h"
 
 byte dscKeypadInterface::dscClockPin;
@@ -90,16 +95,25 @@ byte dscKeypadInterface::dscReadPin;
 byte dscKeypadInterface::dscWritePin;
 int  dscKeypadInterface::clockInterval;
 volatile byte dscKeypadInterface::keyData;
+volatile byte dscKeypadInterface::keyBufferIndex;
 volatile byte dscKeypadInterface::keyBufferLength;
 volatile byte dscKeypadInterface::keyBuffer[dscBufferSize];
+volatile byte dscKeypadInterface::keyBufferPartition[dscBufferSize];
+volatile byte dscKeypadInterface::keyBufferRepeat[dscBufferSize];
+volatile unsigned long dscKeypadInterface::keyBufferTime[dscBufferSize];
+volatile byte dscKeypadInterface::previousKey;
+volatile byte dscKeypadInterface::previousKeyPartition;
+volatile byte dscKeypadInterface::keyRepeatCount;
+volatile unsigned long dscKeypadInterface::previousKeyTime;
+unsigned long dscKeypadInterface::keyRepeatInterval;
 volatile bool dscKeypadInterface::bufferOverflow;
 volatile bool dscKeypadInterface::commandReady;
 volatile bool dscKeypadInterface::moduleDataDetected;
+volatile unsigned long dscKeypadInterface::commandEndTime;
 volatile bool dscKeypadInterface::alarmKeyDetected;
-volatile bool dscKeypadInterface::alarmKeyResponsePending;
 volatile byte dscKeypadInterface::clockCycleCount;
 volatile byte dscKeypadInterface::clockCycleTotal;
-volatile byte dscKeypadInterface::panelCommand[dscReadSize];
+byte* dscKeypadInterface::panelCommand;
 volatile byte dscKeypadInterface::isrPanelBitTotal;
 volatile byte dscKeypadInterface::isrPanelBitCount;
 volatile byte dscKeypadInterface::panelCommandByteCount;
@@ -125,8 +139,14 @@ byte dscClassicKeypadInterface::dscReadPin;
 byte dscClassicKeypadInterface::dscWritePin;
 int  dscClassicKeypadInterface::clockInterval;
 volatile byte dscClassicKeypadInterface::keyData;
+volatile byte dscClassicKeypadInterface::keyBufferIndex;
 volatile byte dscClassicKeypadInterface::keyBufferLength;
 volatile byte dscClassicKeypadInterface::keyBuffer[dscBufferSize];
+volatile byte dscClassicKeypadInterface::keyBufferRepeat[dscBufferSize];
+volatile unsigned long dscClassicKeypadInterface::keyBufferTime[dscBufferSize];
+volatile byte dscClassicKeypadInterface::previousKey;
+volatile byte dscClassicKeypadInterface::keyRepeatCount;
+volatile bool dscClassicKeypadInterface::keyReleased;
 volatile bool dscClassicKeypadInterface::bufferOverflow;
 volatile bool dscClassicKeypadInterface::commandReady;
 volatile bool dscClassicKeypadInterface::moduleDataDetected;
@@ -159,54 +179,18 @@ ISR(TIMER1_OVF_vect) {
 
 
 // DSC PowerSeries
-#else
+#elif !defined dscClassicSeries
 #include "dscKeybus.h"
 
-byte dscKeybusInterface::dscClockPin;
-byte dscKeybusInterface::dscReadPin;
-byte dscKeybusInterface::dscWritePin;
-char dscKeybusInterface::writeKey;
-byte dscKeybusInterface::writePartition;
-byte dscKeybusInterface::writeByte;
-byte dscKeybusInterface::writeBit;
-bool dscKeybusInterface::virtualKeypad;
-bool dscKeybusInterface::processModuleData;
-byte dscKeybusInterface::panelData[dscReadSize];
-byte dscKeybusInterface::panelByteCount;
-byte dscKeybusInterface::panelBitCount;
-volatile bool dscKeybusInterface::writeKeyPending;
-volatile byte dscKeybusInterface::moduleData[dscReadSize];
-volatile bool dscKeybusInterface::moduleDataCaptured;
-volatile bool dscKeybusInterface::moduleDataDetected;
-volatile byte dscKeybusInterface::moduleByteCount;
-volatile byte dscKeybusInterface::moduleBitCount;
-volatile bool dscKeybusInterface::writeAlarm;
-volatile bool dscKeybusInterface::starKeyCheck;
-volatile bool dscKeybusInterface::starKeyWait[dscPartitions];
-volatile bool dscKeybusInterface::bufferOverflow;
-volatile byte dscKeybusInterface::panelBufferLength;
-volatile byte dscKeybusInterface::panelBuffer[dscBufferSize][dscReadSize];
-volatile byte dscKeybusInterface::panelBufferBitCount[dscBufferSize];
-volatile byte dscKeybusInterface::panelBufferByteCount[dscBufferSize];
-volatile byte dscKeybusInterface::isrPanelData[dscReadSize];
-volatile byte dscKeybusInterface::isrPanelByteCount;
-volatile byte dscKeybusInterface::isrPanelBitCount;
-volatile byte dscKeybusInterface::isrPanelBitTotal;
-volatile byte dscKeybusInterface::isrModuleData[dscReadSize];
-volatile byte dscKeybusInterface::currentCmd;
-volatile byte dscKeybusInterface::statusCmd;
-volatile byte dscKeybusInterface::moduleCmd;
-volatile byte dscKeybusInterface::moduleSubCmd;
-volatile unsigned long dscKeybusInterface::clockHighTime;
-volatile unsigned long dscKeybusInterface::keybusTime;
+dscKeybusInterface * dscKeybusInterface::instances[dscInstances];
 
 // Interrupt function called after 250us by dscClockInterrupt() using AVR Timer1, disables the timer and calls
 // dscDataInterrupt() to read the data line
 #if defined(__AVR__)
 ISR(TIMER1_OVF_vect) {
   TCCR1B = 0;  // Disables Timer1
-  dscKeybusInterface::dscDataInterrupt();
+  dscKeybusInterface::dscDataInterrupt0();
 }
 #endif  // __AVR__
-#endif  // dscClassicSeries, dscKeypadInterface
+#endif  // dscKeypad, dscClassicKeypad, dscClassicSeries
 #endif  // dscKeybusInterface_h
@@ -0,0 +1,442 @@
+/*
+    DSC Keybus Interface
+
+    Status message text used by dscKeybusPrintData.cpp, stored in PROGMEM tables to conserve RAM and flash.
+
+    Each table is sorted by message code and maps codes to message text - codes that share text point to the
+    same string.  Messages with a numbered component (zones, access codes, slots) are decoded in
+    dscKeybusPrintData.cpp.  Replacing the text in this file changes the printed messages without changes to
+    the decoding logic.
+
+    https://github.com/taligentx/dscKeybusInterface
+
+    This library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef dscKeybusMessages_h
+#define dscKeybusMessages_h
+
+// printPanelMessages()
+const char panelMessage_01[] PROGMEM = "Partition ready";
+const char panelMessage_02[] PROGMEM = "Stay zones open";
+const char panelMessage_03[] PROGMEM = "Zones open";
+const char panelMessage_04[] PROGMEM = "Armed: Stay";
+const char panelMessage_05[] PROGMEM = "Armed: Away";
+const char panelMessage_06[] PROGMEM = "Armed: Stay with no entry delay";
+const char panelMessage_07[] PROGMEM = "Failed to arm";
+const char panelMessage_08[] PROGMEM = "Exit delay in progress";
+const char panelMessage_09[] PROGMEM = "Arming: No entry delay";
+const char panelMessage_0B[] PROGMEM = "Quick exit in progress";
+const char panelMessage_0C[] PROGMEM = "Entry delay in progress";
+const char panelMessage_0D[] PROGMEM = "Entry delay after alarm";
+const char panelMessage_0E[] PROGMEM = "Function not available";
+const char panelMessage_10[] PROGMEM = "Keypad lockout";
+const char panelMessage_11[] PROGMEM = "Partition in alarm";
+const char panelMessage_12[] PROGMEM = "Battery check in progress";
+const char panelMessage_14[] PROGMEM = "Auto-arm in progress";
+const char panelMessage_15[] PROGMEM = "Arming with bypassed zones";
+const char panelMessage_16[] PROGMEM = "Armed: Away with no entry delay";
+const char panelMessage_17[] PROGMEM = "Keypad blanking";
+const char panelMessage_19[] PROGMEM = "Disarmed: Alarm memory";
+const char panelMessage_22[] PROGMEM = "Disarmed: Recent closing";
+const char panelMessage_2F[] PROGMEM = "Keypad LCD test";
+const char panelMessage_33[] PROGMEM = "Command output in progress";
+const char panelMessage_3E[] PROGMEM = "Partition disarmed";
+const char panelMessage_8A[] PROGMEM = "Activate stay/away zones";
+const char panelMessage_8B[] PROGMEM = "Quick exit";
+const char panelMessage_8F[] PROGMEM = "Invalid access code";
+const char panelMessage_9E[] PROGMEM = "Enter * function key";
+const char panelMessage_9F[] PROGMEM = "Enter access code";
+const char panelMessage_A0[] PROGMEM = "*1: Zone bypass";
+const char panelMessage_A1[] PROGMEM = "*2: Trouble";
+const char panelMessage_A2[] PROGMEM = "*3: Alarm memory";
+const char panelMessage_A3[] PROGMEM = "Door chime enabled";
+const char panelMessage_A4[] PROGMEM = "Door chime disabled";
+const char panelMessage_A5[] PROGMEM = "Enter master code";
+const char panelMessage_A6[] PROGMEM = "*5: Access codes";
+const char panelMessage_A7[] PROGMEM = "*5: Enter 4-digit code";
+const char panelMessage_A9[] PROGMEM = "*6: User functions";
+const char panelMessage_AA[] PROGMEM = "*6: Time and date";
+const char panelMessage_AB[] PROGMEM = "*6: Auto-arm time";
+const char panelMessage_AC[] PROGMEM = "*6: Auto-arm enabled";
+const char panelMessage_AD[] PROGMEM = "*6: Auto-arm disabled";
+const char panelMessage_AF[] PROGMEM = "*6: System test";
+const char panelMessage_B0[] PROGMEM = "*6: Enable DLS";
+const char panelMessage_B2[] PROGMEM = "*7: Command output";
+const char panelMessage_B7[] PROGMEM = "Enter installer code";
+const char panelMessage_B8[] PROGMEM = "Enter * function key while armed";
+const char panelMessage_B9[] PROGMEM = "*2: Zone tamper menu";
+const char panelMessage_BA[] PROGMEM = "*2: Zones with low batteries";
+const char panelMessage_BC[] PROGMEM = "*5: Enter 6-digit code";
+const char panelMessage_BF[] PROGMEM = "*6: Auto-arm select day";
+const char panelMessage_C6[] PROGMEM = "*2: Zone fault menu";
+const char panelMessage_C8[] PROGMEM = "*2: Service required menu";
+const char panelMessage_CD[] PROGMEM = "Downloading in progress";
+const char panelMessage_CE[] PROGMEM = "Active camera monitor selection";
+const char panelMessage_D0[] PROGMEM = "*2: Keypads with low batteries";
+const char panelMessage_D1[] PROGMEM = "*2: Keyfobs with low batteries";
+const char panelMessage_D4[] PROGMEM = "*2: Zones with RF Delinquency";
+const char panelMessage_E4[] PROGMEM = "*8: Installer programming, 3 digits";
+const char panelMessage_E5[] PROGMEM = "Keypad slot assignment";
+const char panelMessage_E6[] PROGMEM = "Input: 2 digits";
+const char panelMessage_E7[] PROGMEM = "Input: 3 digits";
+const char panelMessage_E8[] PROGMEM = "Input: 4 digits";
+const char panelMessage_E9[] PROGMEM = "Input: 5 digits";
+const char panelMessage_EA[] PROGMEM = "Input HEX: 2 digits";
+const char panelMessage_EB[] PROGMEM = "Input HEX: 4 digits";
+const char panelMessage_EC[] PROGMEM = "Input HEX: 6 digits";
+const char panelMessage_ED[] PROGMEM = "Input HEX: 32 digits";
+const char panelMessage_EE[] PROGMEM = "Input: 1 option per zone";
+const char panelMessage_EF[] PROGMEM = "Module supervision field";
+const char panelMessage_F0[] PROGMEM = "Function key 1";
+const char panelMessage_F1[] PROGMEM = "Function key 2";
+const char panelMessage_F2[] PROGMEM = "Function key 3";
+const char panelMessage_F3[] PROGMEM = "Function key 4";
+const char panelMessage_F4[] PROGMEM = "Function key 5";
+const char panelMessage_F5[] PROGMEM = "Wireless module placement test";
+const char panelMessage_F6[] PROGMEM = "Activate device for test";
+const char panelMessage_F7[] PROGMEM = "*8: Installer programming, 2 digits";
+const char panelMessage_F8[] PROGMEM = "Keypad programming";
+const char panelMessage_FA[] PROGMEM = "Input: 6 digits";
+
+const dscMessage panelMessages[] PROGMEM = {
+  {0x01, panelMessage_01},
+  {0x02, panelMessage_02},
+  {0x03, panelMessage_03},
+  {0x04, panelMessage_04},
+  {0x05, panelMessage_05},
+  {0x06, panelMessage_06},
+  {0x07, panelMessage_07},
+  {0x08, panelMessage_08},
+  {0x09, panelMessage_09},
+  {0x0B, panelMessage_0B},
+  {0x0C, panelMessage_0C},
+  {0x0D, panelMessage_0D},
+  {0x0E, panelMessage_0E},
+  {0x10, panelMessage_10},
+  {0x11, panelMessage_11},
+  {0x12, panelMessage_12},
+  {0x14, panelMessage_14},
+  {0x15, panelMessage_15},
+  {0x16, panelMessage_16},
+  {0x17, panelMessage_17},  // Keypad blanking with trouble light flashing
+  {0x19, panelMessage_19},
+  {0x22, panelMessage_22},
+  {0x2F, panelMessage_2F},
+  {0x33, panelMessage_33},
+  {0x3D, panelMessage_19},
+  {0x3E, panelMessage_3E},
+  {0x40, panelMessage_17},
+  {0x8A, panelMessage_8A},
+  {0x8B, panelMessage_8B},
+  {0x8E, panelMessage_0E},
+  {0x8F, panelMessage_8F},
+  {0x9E, panelMessage_9E},
+  {0x9F, panelMessage_9F},
+  {0xA0, panelMessage_A0},
+  {0xA1, panelMessage_A1},
+  {0xA2, panelMessage_A2},
+  {0xA3, panelMessage_A3},
+  {0xA4, panelMessage_A4},
+  {0xA5, panelMessage_A5},
+  {0xA6, panelMessage_A6},
+  {0xA7, panelMessage_A7},
+  {0xA9, panelMessage_A9},
+  {0xAA, panelMessage_AA},
+  {0xAB, panelMessage_AB},
+  {0xAC, panelMessage_AC},
+  {0xAD, panelMessage_AD},
+  {0xAF, panelMessage_AF},
+  {0xB0, panelMessage_B0},
+  {0xB2, panelMessage_B2},
+  {0xB3, panelMessage_B2},
+  {0xB7, panelMessage_B7},
+  {0xB8, panelMessage_B8},
+  {0xB9, panelMessage_B9},
+  {0xBA, panelMessage_BA},
+  {0xBC, panelMessage_BC},
+  {0xBF, panelMessage_BF},
+  {0xC6, panelMessage_C6},
+  // 0xC7: Partition not available
+  {0xC8, panelMessage_C8},
+  {0xCD, panelMessage_CD},
+  {0xCE, panelMessage_CE},
+  {0xD0, panelMessage_D0},
+  {0xD1, panelMessage_D1},
+  {0xD4, panelMessage_D4},
+  {0xE4, panelMessage_E4},
+  {0xE5, panelMessage_E5},
+  {0xE6, panelMessage_E6},
+  {0xE7, panelMessage_E7},
+  {0xE8, panelMessage_E8},
+  {0xE9, panelMessage_E9},
+  {0xEA, panelMessage_EA},
+  {0xEB, panelMessage_EB},
+  {0xEC, panelMessage_EC},
+  {0xED, panelMessage_ED},
+  {0xEE, panelMessage_EE},
+  {0xEF, panelMessage_EF},
+  {0xF0, panelMessage_F0},
+  {0xF1, panelMessage_F1},
+  {0xF2, panelMessage_F2},
+  {0xF3, panelMessage_F3},
+  {0xF4, panelMessage_F4},
+  {0xF5, panelMessage_F5},
+  {0xF6, panelMessage_F6},
+  {0xF7, panelMessage_F7},
+  {0xF8, panelMessage_F8},
+  {0xFA, panelMessage_FA}
+};
+
+// printPanelStatus0()
+const char panelStatus0_49[] PROGMEM = "Duress alarm";
+const char panelStatus0_4A[] PROGMEM = "Disarmed: Alarm memory";
+const char panelStatus0_4B[] PROGMEM = "Recent closing alarm";
+const char panelStatus0_4C[] PROGMEM = "Zone expander supervisory alarm";
+const char panelStatus0_4D[] PROGMEM = "Zone expander supervisory restored";
+const char panelStatus0_4E[] PROGMEM = "Keypad Fire alarm";
+const char panelStatus0_4F[] PROGMEM = "Keypad Aux alarm";
+const char panelStatus0_50[] PROGMEM = "Keypad Panic alarm";
+const char panelStatus0_51[] PROGMEM = "PGM2 input alarm";
+const char panelStatus0_52[] PROGMEM = "Keypad Fire alarm restored";
+const char panelStatus0_53[] PROGMEM = "Keypad Aux alarm restored";
+const char panelStatus0_54[] PROGMEM = "Keypad Panic alarm restored";
+const char panelStatus0_55[] PROGMEM = "PGM2 input alarm restored";
+const char panelStatus0_98[] PROGMEM = "Keypad lockout";
+const char panelStatus0_BE[] PROGMEM = "Armed: Partial";
+const char panelStatus0_BF[] PROGMEM = "Armed: Special";
+const char panelStatus0_E5[] PROGMEM = "Auto-arm cancelled";
+const char panelStatus0_E6[] PROGMEM = "Disarmed: Special";
+const char panelStatus0_E7[] PROGMEM = "Panel battery trouble";
+const char panelStatus0_E8[] PROGMEM = "Panel AC power trouble";
+const char panelStatus0_E9[] PROGMEM = "Bell trouble";
+const char panelStatus0_EA[] PROGMEM = "Fire zone trouble";
+const char panelStatus0_EB[] PROGMEM = "Panel aux supply trouble";
+const char panelStatus0_EC[] PROGMEM = "Telephone line trouble";
+const char panelStatus0_EF[] PROGMEM = "Panel battery restored";
+const char panelStatus0_F0[] PROGMEM = "Panel AC power restored";
+const char panelStatus0_F1[] PROGMEM = "Bell restored";
+const char panelStatus0_F2[] PROGMEM = "Fire zone trouble restored";
+const char panelStatus0_F3[] PROGMEM = "Panel aux supply restored";
+const char panelStatus0_F4[] PROGMEM = "Telephone line restored";
+const char panelStatus0_F7[] PROGMEM = "Phone 1 FTC";
+const char panelStatus0_F8[] PROGMEM = "Phone 2 FTC";
+const char panelStatus0_F9[] PROGMEM = "Event buffer threshold";
+const char panelStatus0_FA[] PROGMEM = "DLS lead-in";
+const char panelStatus0_FB[] PROGMEM = "DLS lead-out";
+const char panelStatus0_FE[] PROGMEM = "Periodic test transmission";
+const char panelStatus0_FF[] PROGMEM = "System test";
+
+const dscMessage panelStatus0[] PROGMEM = {
+  {0x49, panelStatus0_49},
+  {0x4A, panelStatus0_4A},
+  {0x4B, panelStatus0_4B},
+  {0x4C, panelStatus0_4C},
+  {0x4D, panelStatus0_4D},
+  {0x4E, panelStatus0_4E},
+  {0x4F, panelStatus0_4F},
+  {0x50, panelStatus0_50},
+  {0x51, panelStatus0_51},
+  {0x52, panelStatus0_52},
+  {0x53, panelStatus0_53},
+  {0x54, panelStatus0_54},
+  {0x55, panelStatus0_55},
+  {0x98, panelStatus0_98},
+  {0xBE, panelStatus0_BE},
+  {0xBF, panelStatus0_BF},
+  {0xE5, panelStatus0_E5},
+  {0xE6, panelStatus0_E6},
+  {0xE7, panelStatus0_E7},
+  {0xE8, panelStatus0_E8},
+  {0xE9, panelStatus0_E9},
+  {0xEA, panelStatus0_EA},
+  {0xEB, panelStatus0_EB},
+  {0xEC, panelStatus0_EC},
+  {0xEF, panelStatus0_EF},
+  {0xF0, panelStatus0_F0},
+  {0xF1, panelStatus0_F1},
+  {0xF2, panelStatus0_F2},
+  {0xF3, panelStatus0_F3},
+  {0xF4, panelStatus0_F4},
+  {0xF7, panelStatus0_F7},
+  {0xF8, panelStatus0_F8},
+  {0xF9, panelStatus0_F9},  //75% full since last DLS upload
+  {0xFA, panelStatus0_FA},
+  {0xFB, panelStatus0_FB},
+  {0xFE, panelStatus0_FE},
+  {0xFF, panelStatus0_FF}
+};
+
+// printPanelStatus1()
+const char panelStatus1_03[] PROGMEM = "Cross zone alarm";
+const char panelStatus1_04[] PROGMEM = "Delinquency alarm";
+const char panelStatus1_05[] PROGMEM = "Late to close";
+const char panelStatus1_29[] PROGMEM = "Downloading forced answer";
+const char panelStatus1_2B[] PROGMEM = "Armed: Auto-arm";
+const char panelStatus1_AC[] PROGMEM = "Exit installer programming";
+const char panelStatus1_AD[] PROGMEM = "Enter installer programming";
+const char panelStatus1_AE[] PROGMEM = "Walk test end";
+const char panelStatus1_AF[] PROGMEM = "Walk test begin";
+const char panelStatus1_D0[] PROGMEM = "Command output 4";
+const char panelStatus1_D1[] PROGMEM = "Exit fault pre-alert";
+const char panelStatus1_D2[] PROGMEM = "Armed: Entry delay";
+const char panelStatus1_D3[] PROGMEM = "Downlook remote trigger";
+
+const dscMessage panelStatus1[] PROGMEM = {
+  {0x03, panelStatus1_03},
+  {0x04, panelStatus1_04},
+  {0x05, panelStatus1_05},
+  {0x29, panelStatus1_29},
+  {0x2B, panelStatus1_2B},
+  {0xAC, panelStatus1_AC},
+  {0xAD, panelStatus1_AD},
+  {0xAE, panelStatus1_AE},
+  {0xAF, panelStatus1_AF},
+  {0xD0, panelStatus1_D0},
+  {0xD1, panelStatus1_D1},
+  {0xD2, panelStatus1_D2},
+  {0xD3, panelStatus1_D3}
+};
+
+// printPanelStatus2()
+const char panelStatus2_2A[] PROGMEM = "Quick exit";
+const char panelStatus2_63[] PROGMEM = "Keybus fault restored";
+const char panelStatus2_64[] PROGMEM = "Keybus fault";
+const char panelStatus2_66[] PROGMEM = "*1: Zone bypass";
+const char panelStatus2_8C[] PROGMEM = "Cold start";
+const char panelStatus2_8D[] PROGMEM = "Warm start";
+const char panelStatus2_8E[] PROGMEM = "Panel factory default";
+const char panelStatus2_91[] PROGMEM = "Swinger shutdown";
+const char panelStatus2_93[] PROGMEM = "Disarmed: Keyswitch";
+const char panelStatus2_96[] PROGMEM = "Armed: Keyswitch";
+const char panelStatus2_97[] PROGMEM = "Armed: Keypad away";
+const char panelStatus2_98[] PROGMEM = "Armed: Quick-arm";
+const char panelStatus2_99[] PROGMEM = "Activate stay/away zones";
+const char panelStatus2_9A[] PROGMEM = "Armed: Stay";
+const char panelStatus2_9B[] PROGMEM = "Armed: Away";
+const char panelStatus2_9C[] PROGMEM = "Armed: No entry delay";
+const char panelStatus2_FF[] PROGMEM = "Zone expander trouble: 1";
+
+const dscMessage panelStatus2[] PROGMEM = {
+  {0x2A, panelStatus2_2A},
+  {0x63, panelStatus2_63},
+  {0x64, panelStatus2_64},
+  {0x66, panelStatus2_66},
+  {0x8C, panelStatus2_8C},
+  {0x8D, panelStatus2_8D},
+  {0x8E, panelStatus2_8E},
+  {0x91, panelStatus2_91},
+  {0x93, panelStatus2_93},
+  {0x96, panelStatus2_96},
+  {0x97, panelStatus2_97},
+  {0x98, panelStatus2_98},
+  {0x99, panelStatus2_99},
+  {0x9A, panelStatus2_9A},
+  {0x9B, panelStatus2_9B},
+  {0x9C, panelStatus2_9C},
+  {0xFF, panelStatus2_FF}
+};
+
+// printPanelStatus3()
+const char panelStatus3_05[] PROGMEM = "PC/RF5132: Supervisory restored";
+const char panelStatus3_06[] PROGMEM = "PC/RF5132: Supervisory trouble";
+const char panelStatus3_09[] PROGMEM = "PC5204: Supervisory restored";
+const char panelStatus3_0A[] PROGMEM = "PC5204: Supervisory trouble";
+const char panelStatus3_17[] PROGMEM = "Zone expander restored: 7";
+const char panelStatus3_18[] PROGMEM = "Zone expander trouble: 7";
+const char panelStatus3_41[] PROGMEM = "PC/RF5132: Tamper restored";
+const char panelStatus3_42[] PROGMEM = "PC/RF5132: Tamper";
+const char panelStatus3_43[] PROGMEM = "PC5208: Tamper restored";
+const char panelStatus3_44[] PROGMEM = "PC5208: Tamper";
+const char panelStatus3_45[] PROGMEM = "PC5204: Tamper restored";
+const char panelStatus3_46[] PROGMEM = "PC5204: Tamper";
+const char panelStatus3_51[] PROGMEM = "Zone expander tamper restored: 7";
+const char panelStatus3_52[] PROGMEM = "Zone expander tamper: 7";
+const char panelStatus3_B3[] PROGMEM = "PC5204: Battery restored";
+const char panelStatus3_B4[] PROGMEM = "PC5204: Battery trouble";
+const char panelStatus3_B5[] PROGMEM = "PC5204: Aux supply restored";
+const char panelStatus3_B6[] PROGMEM = "PC5204: Aux supply trouble";
+const char panelStatus3_B7[] PROGMEM = "PC5204: Output 1 restored";
+const char panelStatus3_B8[] PROGMEM = "PC5204: Output 1 trouble";
+const char panelStatus3_FF[] PROGMEM = "Extended status";
+
+const dscMessage panelStatus3[] PROGMEM = {
+  {0x05, panelStatus3_05},
+  {0x06, panelStatus3_06},
+  {0x09, panelStatus3_09},
+  {0x0A, panelStatus3_0A},
+  {0x17, panelStatus3_17},
+  {0x18, panelStatus3_18},
+  {0x41, panelStatus3_41},
+  {0x42, panelStatus3_42},
+  {0x43, panelStatus3_43},
+  {0x44, panelStatus3_44},
+  {0x45, panelStatus3_45},
+  {0x46, panelStatus3_46},
+  {0x51, panelStatus3_51},
+  {0x52, panelStatus3_52},
+  {0xB3, panelStatus3_B3},
+  {0xB4, panelStatus3_B4},
+  {0xB5, panelStatus3_B5},
+  {0xB6, panelStatus3_B6},
+  {0xB7, panelStatus3_B7},
+  {0xB8, panelStatus3_B8},
+  {0xFF, panelStatus3_FF}
+};
+
+// printPanelStatus4()
+const char panelStatus4_86[] PROGMEM = "Periodic test with trouble";
+const char panelStatus4_87[] PROGMEM = "Exit fault";
+const char panelStatus4_89[] PROGMEM = "Alarm cancelled";
+
+const dscMessage panelStatus4[] PROGMEM = {
+  {0x86, panelStatus4_86},
+  {0x87, panelStatus4_87},
+  {0x89, panelStatus4_89}
+};
+
+#if !defined(__AVR__)  // Excludes Arduino/AVR to conserve storage space
+// printPanelStatus14()
+const char panelStatus14_C0[] PROGMEM = "TLink com fault";
+const char panelStatus14_C2[] PROGMEM = "Tlink network fault";
+const char panelStatus14_C4[] PROGMEM = "TLink receiver trouble";
+const char panelStatus14_C5[] PROGMEM = "TLink receiver restored";
+
+const dscMessage panelStatus14[] PROGMEM = {
+  {0xC0, panelStatus14_C0},
+  {0xC2, panelStatus14_C2},
+  {0xC4, panelStatus14_C4},
+  {0xC5, panelStatus14_C5}
+};
+#endif
+
+// printPanelStatus16()
+const char panelStatus16_80[] PROGMEM = "Trouble acknowledged";
+const char panelStatus16_81[] PROGMEM = "RF delinquency trouble";
+const char panelStatus16_82[] PROGMEM = "RF delinquency restore";
+
+const dscMessage panelStatus16[] PROGMEM = {
+  {0x80, panelStatus16_80},
+  {0x81, panelStatus16_81},
+  {0x82, panelStatus16_82}
+};
+
+// printPanelStatus1B()
+const char panelStatus1B_F1[] PROGMEM = "System reset transmission";
+
+const dscMessage panelStatus1B[] PROGMEM = {
+  {0xF1, panelStatus1B_F1}
+};
+
+#endif // dscKeybusMessages_h
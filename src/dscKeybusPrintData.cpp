@@ -30,6 +30,7 @@
  */
 
  #include "dscKeybus.h"
+ #include "dscKeybusMessages.h"
 
 
 /*
@@ -44,30 +45,9 @@
 void dscKeybusInterface::printPanelMessage() {
 
   // Checks for errors on panel commands with CRC data
-  switch (panelData[0]) {
-    case 0x05:         // Skips panel commands without CRC data
-    case 0x11:
-    case 0x1B:
-    case 0x1C:
-    case 0x22:
-    case 0x28:
-    case 0x33:
-    case 0x39:
-    case 0x41:
-    case 0x4C:
-    case 0x57:
-    case 0x58:
-    case 0x70:
-    case 0x94:
-    case 0x9E:
-    case 0xD5:
-    case 0xE6: break;  // 0xE6 is checked separately as only some of its subcommands use CRC
-    default: {         // Checks remaining panel commands
-      if (!validCRC()) {
-        stream->print(F("[CRC Error]"));
-        return;
-      }
-    }
+  if (panelCRC() && !validCRC()) {
+    stream->print(F("[CRC Error]"));
+    return;
   }
 
   // Processes known panel commands from the first byte of the panel message: panelData[0]
@@ -218,98 +198,16 @@ void dscKeybusInterface::printPanelLights(byte panelByte, bool printMessage) {
  */
 void dscKeybusInterface::printPanelMessages(byte panelByte) {
   switch (panelData[panelByte]) {
-    case 0x01: stream->print(F("Partition ready")); break;
-    case 0x02: stream->print(F("Stay zones open")); break;
-    case 0x03: stream->print(F("Zones open")); break;
-    case 0x04: stream->print(F("Armed: Stay")); break;
-    case 0x05: stream->print(F("Armed: Away")); break;
-    case 0x06: stream->print(F("Armed: Stay with no entry delay")); break;
-    case 0x07: stream->print(F("Failed to arm")); break;
-    case 0x08: stream->print(F("Exit delay in progress")); break;
-    case 0x09: stream->print(F("Arming: No entry delay")); break;
-    case 0x0B: stream->print(F("Quick exit in progress")); break;
-    case 0x0C: stream->print(F("Entry delay in progress")); break;
-    case 0x0D: stream->print(F("Entry delay after alarm")); break;
-    case 0x0E: stream->print(F("Function not available")); break;
-    case 0x10: stream->print(F("Keypad lockout")); break;
-    case 0x11: stream->print(F("Partition in alarm")); break;
-    case 0x12: stream->print(F("Battery check in progress")); break;
-    case 0x14: stream->print(F("Auto-arm in progress")); break;
-    case 0x15: stream->print(F("Arming with bypassed zones")); break;
-    case 0x16: stream->print(F("Armed: Away with no entry delay")); break;
-    case 0x19: stream->print(F("Disarmed: Alarm memory")); break;
-    case 0x22: stream->print(F("Disarmed: Recent closing")); break;
-    case 0x2F: stream->print(F("Keypad LCD test")); break;
-    case 0x33: stream->print(F("Command output in progress")); break;
-    case 0x3D: stream->print(F("Disarmed: Alarm memory")); break;
-    case 0x3E: stream->print(F("Partition disarmed")); break;
-    case 0x17: // Keypad blanking with trouble light flashing
-    case 0x40: stream->print(F("Keypad blanking")); break;
-    case 0x8A: stream->print(F("Activate stay/away zones")); break;
-    case 0x8B: stream->print(F("Quick exit")); break;
-    case 0x8E: stream->print(F("Function not available")); break;
-    case 0x8F: stream->print(F("Invalid access code")); break;
-    case 0x9E: stream->print(F("Enter * function key")); break;
-    case 0x9F: stream->print(F("Enter access code")); break;
-    case 0xA0: stream->print(F("*1: Zone bypass")); break;
-    case 0xA1: stream->print(F("*2: Trouble")); break;
-    case 0xA2: stream->print(F("*3: Alarm memory")); break;
-    case 0xA3: stream->print(F("Door chime enabled")); break;
-    case 0xA4: stream->print(F("Door chime disabled")); break;
-    case 0xA5: stream->print(F("Enter master code")); break;
-    case 0xA6: stream->print(F("*5: Access codes")); break;
-    case 0xA7: stream->print(F("*5: Enter 4-digit code")); break;
-    case 0xA9: stream->print(F("*6: User functions")); break;
-    case 0xAA: stream->print(F("*6: Time and date")); break;
-    case 0xAB: stream->print(F("*6: Auto-arm time")); break;
-    case 0xAC: stream->print(F("*6: Auto-arm enabled")); break;
-    case 0xAD: stream->print(F("*6: Auto-arm disabled")); break;
-    case 0xAF: stream->print(F("*6: System test")); break;
-    case 0xB0: stream->print(F("*6: Enable DLS")); break;
-    case 0xB2:
-    case 0xB3: stream->print(F("*7: Command output")); break;
-    case 0xB7: stream->print(F("Enter installer code")); break;
-    case 0xB8: stream->print(F("Enter * function key while armed")); break;
-    case 0xB9: stream->print(F("*2: Zone tamper menu")); break;
-    case 0xBA: stream->print(F("*2: Zones with low batteries")); break;
-    case 0xBC: stream->print(F("*5: Enter 6-digit code")); break;
-    case 0xBF: stream->print(F("*6: Auto-arm select day")); break;
-    case 0xC6: stream->print(F("*2: Zone fault menu")); break;
-    //case 0xC7: stream->print(F("Partition not available")); break;
-    case 0xC8: stream->print(F("*2: Service required menu")); break;
-    case 0xCD: stream->print(F("Downloading in progress")); break;
-    case 0xCE: stream->print(F("Active camera monitor selection")); break;
-    case 0xD0: stream->print(F("*2: Keypads with low batteries")); break;
-    case 0xD1: stream->print(F("*2: Keyfobs with low batteries")); break;
-    case 0xD4: stream->print(F("*2: Zones with RF Delinquency")); break;
-    case 0xE4: stream->print(F("*8: Installer programming, 3 digits")); decimalInput = false; break;
-    case 0xE5: stream->print(F("Keypad slot assignment")); break;
-    case 0xE6: stream->print(F("Input: 2 digits")); break;
-    case 0xE7: stream->print(F("Input: 3 digits")); decimalInput = true; break;
-    case 0xE8: stream->print(F("Input: 4 digits")); break;
-    case 0xE9: stream->print(F("Input: 5 digits")); break;
-    case 0xEA: stream->print(F("Input HEX: 2 digits")); break;
-    case 0xEB: stream->print(F("Input HEX: 4 digits")); break;
-    case 0xEC: stream->print(F("Input HEX: 6 digits")); break;
-    case 0xED: stream->print(F("Input HEX: 32 digits")); break;
-    case 0xEE: stream->print(F("Input: 1 option per zone")); break;
-    case 0xEF: stream->print(F("Module supervision field")); break;
-    case 0xF0: stream->print(F("Function key 1")); break;
-    case 0xF1: stream->print(F("Function key 2")); break;
-    case 0xF2: stream->print(F("Function key 3")); break;
-    case 0xF3: stream->print(F("Function key 4")); break;
-    case 0xF4: stream->print(F("Function key 5")); break;
-    case 0xF5: stream->print(F("Wireless module placement test")); break;
-    case 0xF6: stream->print(F("Activate device for test")); break;
-    case 0xF7: stream->print(F("*8: Installer programming, 2 digits")); decimalInput = false; break;
-    case 0xF8: stream->print(F("Keypad programming")); break;
-    case 0xFA: stream->print(F("Input: 6 digits")); break;
-    default:
-      stream->print(F("Unknown data: 0x"));
-      if (panelData[panelByte] < 10) stream->print("0");
-      stream->print(panelData[panelByte], HEX);
-      break;
+    case 0xE4: decimalInput = false; break;  // *8: Installer programming, 3 digits
+    case 0xE7: decimalInput = true; break;   // Input: 3 digits
+    case 0xF7: decimalInput = false; break;  // *8: Installer programming, 2 digits
   }
+
+  if (printPanelText(panelMessages, dscMessageCount(panelMessages), panelByte)) return;
+
+  stream->print(F("Unknown data: 0x"));
+  if (panelData[panelByte] < 10) stream->print("0");
+  stream->print(panelData[panelByte], HEX);
 }
 
 
@@ -323,85 +221,44 @@ void dscKeybusInterface::printPanelMessages(byte panelByte) {
  *  select from multiple sets of status messages, split into printPanelStatus0...printPanelStatus2.
  */
 void dscKeybusInterface::printPanelStatus0(byte panelByte) {
-  bool decoded = true;
-  switch (panelData[panelByte]) {
-    /*
-     *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
-     *  10100101 0 00011000 01001111 10110000 11101100 01001001 11111111 11110000 [0xA5] 2018.03.29 16:59 | Partition 1 | Duress alarm
-     *  10100101 0 00011000 01001111 11001110 10111100 01001010 11111111 11011111 [0xA5] 2018.03.30 14:47 | Partition 1 | Disarmed after alarm in memory
-     *  10100101 0 00011000 01001111 11001010 01000100 01001011 11111111 01100100 [0xA5] 2018.03.30 10:17 | Partition 1 | Partition in alarm
-     *  10100101 0 00011000 01010000 01001001 10111000 01001100 11111111 01011001 [0xA5] 2018.04.02 09:46 | Partition 1 | Zone expander supervisory alarm
-     *  10100101 0 00011000 01010000 01001010 00000000 01001101 11111111 10100011 [0xA5] 2018.04.02 10:00 | Partition 1 | Zone expander supervisory restored
-     *  10100101 0 00011000 01001111 01110010 10011100 01001110 11111111 01100111 [0xA5] 2018.03.27 18:39 | Partition 1 | Keypad Fire alarm
-     *  10100101 0 00011000 01001111 01110010 10010000 01001111 11111111 01011100 [0xA5] 2018.03.27 18:36 | Partition 1 | Keypad Aux alarm
-     *  10100101 0 00011000 01001111 01110010 10001000 01010000 11111111 01010101 [0xA5] 2018.03.27 18:34 | Partition 1 | Keypad Panic alarm
-     *  10100101 0 00010110 00010111 11101101 00010000 01010000 10010001 10110000 [0xA5] 2016.05.31 13:04 | Keypad Panic alarm
-     *  10100101 0 00010001 01101101 01100000 00000100 01010001 11111111 11010111 [0xA5] 2011.11.11 00:01 | Partition 1 | Auxiliary input alarm
-     *  10100101 0 00011000 01001111 01110010 10011100 01010010 11111111 01101011 [0xA5] 2018.03.27 18:39 | Partition 1 | Keypad Fire alarm restored
-     *  10100101 0 00011000 01001111 01110010 10010000 01010011 11111111 01100000 [0xA5] 2018.03.27 18:36 | Partition 1 | Keypad Aux alarm restored
-     *  10100101 0 00011000 01001111 01110010 10001000 01010100 11111111 01011001 [0xA5] 2018.03.27 18:34 | Partition 1 | Keypad Panic alarm restored
-     *  10100101 0 00011000 01001111 11110110 00110100 10011000 11111111 11001101 [0xA5] 2018.03.31 22:13 | Partition 1 | Keypad lockout
-     *  10100101 0 00011000 01001111 11101011 10100100 10111110 11111111 01011000 [0xA5] 2018.03.31 11:41 | Partition 1 | Armed partial: Zones bypassed
-     *  10100101 0 00011000 01001111 11101011 00011000 10111111 11111111 11001101 [0xA5] 2018.03.31 11:06 | Partition 1 | Armed special: quick-arm/auto-arm/keyswitch/wireless key/DLS
-     *  10100101 0 00010001 01101101 01100000 00101000 11100101 11111111 10001111 [0xA5] 2011.11.11 00:10 | Partition 1 | Auto-arm cancelled
-     *  10100101 0 00011000 01001111 11110111 01000000 11100110 11111111 00101000 [0xA5] 2018.03.31 23:16 | Partition 1 | Disarmed special: keyswitch/wireless key/DLS
-     *  10100101 0 00011000 01001111 01101111 01011100 11100111 11111111 10111101 [0xA5] 2018.03.27 15:23 | Partition 1 | Panel battery trouble
-     *  10100101 0 00011000 01001111 10110011 10011000 11101000 11111111 00111110 [0xA5] 2018.03.29 19:38 | Partition 1 | Panel AC power trouble
-     *  10100101 0 00011000 01001111 01110100 01010000 11101001 11111111 10111000 [0xA5] 2018.03.27 20:20 | Partition 1 | Bell trouble
-     *  10100101 0 00011000 01001111 11000000 10001000 11101100 11111111 00111111 [0xA5] 2018.03.30 00:34 | Partition 1 | Telephone line trouble
-     *  10100101 0 00011000 01001111 01101111 01110000 11101111 11111111 11011001 [0xA5] 2018.03.27 15:28 | Partition 1 | Panel battery restored
-     *  10100101 0 00011000 01010000 00100000 01011000 11110000 11111111 01110100 [0xA5] 2018.04.01 00:22 | Partition 1 | Panel AC power restored
-     *  10100101 0 00011000 01001111 01110100 01011000 11110001 11111111 11001000 [0xA5] 2018.03.27 20:22 | Partition 1 | Bell restored
-     *  10100101 0 00011000 01001111 11000000 10001000 11110100 11111111 01000111 [0xA5] 2018.03.30 00:34 | Partition 1 | Telephone line restored
-     *  10100101 0 00011000 01001111 11100001 01011000 11111111 11111111 01000011 [0xA5] 2018.03.31 01:22 | Partition 1 | System test
-     *  Byte 0   1    2        3        4        5        6        7        8
-     */
-    // 0x09 - 0x28: Zone alarm, zones 1-32
-    // 0x29 - 0x48: Zone alarm restored, zones 1-32
-    case 0x49: stream->print(F("Duress alarm")); break;
-    case 0x4A: stream->print(F("Disarmed: Alarm memory")); break;
-    case 0x4B: stream->print(F("Recent closing alarm")); break;
-    case 0x4C: stream->print(F("Zone expander supervisory alarm")); break;
-    case 0x4D: stream->print(F("Zone expander supervisory restored")); break;
-    case 0x4E: stream->print(F("Keypad Fire alarm")); break;
-    case 0x4F: stream->print(F("Keypad Aux alarm")); break;
-    case 0x50: stream->print(F("Keypad Panic alarm")); break;
-    case 0x51: stream->print(F("PGM2 input alarm")); break;
-    case 0x52: stream->print(F("Keypad Fire alarm restored")); break;
-    case 0x53: stream->print(F("Keypad Aux alarm restored")); break;
-    case 0x54: stream->print(F("Keypad Panic alarm restored")); break;
-    case 0x55: stream->print(F("PGM2 input alarm restored")); break;
-    // 0x56 - 0x75: Zone tamper, zones 1-32
-    // 0x76 - 0x95: Zone tamper restored, zones 1-32
-    case 0x98: stream->print(F("Keypad lockout")); break;
-    // 0x99 - 0xBD: Armed: Access codes 1-34, 40-42
-    case 0xBE: stream->print(F("Armed: Partial")); break;
-    case 0xBF: stream->print(F("Armed: Special")); break;
-    // 0xC0 - 0xE4: Disarmed: Access codes 1-34, 40-42
-    case 0xE5: stream->print(F("Auto-arm cancelled")); break;
-    case 0xE6: stream->print(F("Disarmed: Special")); break;
-    case 0xE7: stream->print(F("Panel battery trouble")); break;
-    case 0xE8: stream->print(F("Panel AC power trouble")); break;
-    case 0xE9: stream->print(F("Bell trouble")); break;
-    case 0xEA: stream->print(F("Fire zone trouble")); break;
-    case 0xEB: stream->print(F("Panel aux supply trouble")); break;
-    case 0xEC: stream->print(F("Telephone line trouble")); break;
-    case 0xEF: stream->print(F("Panel battery restored")); break;
-    case 0xF0: stream->print(F("Panel AC power restored")); break;
-    case 0xF1: stream->print(F("Bell restored")); break;
-    case 0xF2: stream->print(F("Fire zone trouble restored")); break;
-    case 0xF3: stream->print(F("Panel aux supply restored")); break;
-    case 0xF4: stream->print(F("Telephone line restored")); break;
-    case 0xF7: stream->print(F("Phone 1 FTC")); break;
-    case 0xF8: stream->print(F("Phone 2 FTC")); break;
-    case 0xF9: stream->print(F("Event buffer threshold")); break;  //75% full since last DLS upload
-    case 0xFA: stream->print(F("DLS lead-in")); break;
-    case 0xFB: stream->print(F("DLS lead-out")); break;
-    case 0xFE: stream->print(F("Periodic test transmission")); break;
-    case 0xFF: stream->print(F("System test")); break;
-    default: decoded = false;
-  }
-  if (decoded) return;
+  /*
+   *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
+   *  10100101 0 00011000 01001111 10110000 11101100 01001001 11111111 11110000 [0xA5] 2018.03.29 16:59 | Partition 1 | Duress alarm
+   *  10100101 0 00011000 01001111 11001110 10111100 01001010 11111111 11011111 [0xA5] 2018.03.30 14:47 | Partition 1 | Disarmed after alarm in memory
+   *  10100101 0 00011000 01001111 11001010 01000100 01001011 11111111 01100100 [0xA5] 2018.03.30 10:17 | Partition 1 | Partition in alarm
+   *  10100101 0 00011000 01010000 01001001 10111000 01001100 11111111 01011001 [0xA5] 2018.04.02 09:46 | Partition 1 | Zone expander supervisory alarm
+   *  10100101 0 00011000 01010000 01001010 00000000 01001101 11111111 10100011 [0xA5] 2018.04.02 10:00 | Partition 1 | Zone expander supervisory restored
+   *  10100101 0 00011000 01001111 01110010 10011100 01001110 11111111 01100111 [0xA5] 2018.03.27 18:39 | Partition 1 | Keypad Fire alarm
+   *  10100101 0 00011000 01001111 01110010 10010000 01001111 11111111 01011100 [0xA5] 2018.03.27 18:36 | Partition 1 | Keypad Aux alarm
+   *  10100101 0 00011000 01001111 01110010 10001000 01010000 11111111 01010101 [0xA5] 2018.03.27 18:34 | Partition 1 | Keypad Panic alarm
+   *  10100101 0 00010110 00010111 11101101 00010000 01010000 10010001 10110000 [0xA5] 2016.05.31 13:04 | Keypad Panic alarm
+   *  10100101 0 00010001 01101101 01100000 00000100 01010001 11111111 11010111 [0xA5] 2011.11.11 00:01 | Partition 1 | Auxiliary input alarm
+   *  10100101 0 00011000 01001111 01110010 10011100 01010010 11111111 01101011 [0xA5] 2018.03.27 18:39 | Partition 1 | Keypad Fire alarm restored
+   *  10100101 0 00011000 01001111 01110010 10010000 01010011 11111111 01100000 [0xA5] 2018.03.27 18:36 | Partition 1 | Keypad Aux alarm restored
+   *  10100101 0 00011000 01001111 01110010 10001000 01010100 11111111 01011001 [0xA5] 2018.03.27 18:34 | Partition 1 | Keypad Panic alarm restored
+   *  10100101 0 00011000 01001111 11110110 00110100 10011000 11111111 11001101 [0xA5] 2018.03.31 22:13 | Partition 1 | Keypad lockout
+   *  10100101 0 00011000 01001111 11101011 10100100 10111110 11111111 01011000 [0xA5] 2018.03.31 11:41 | Partition 1 | Armed partial: Zones bypassed
+   *  10100101 0 00011000 01001111 11101011 00011000 10111111 11111111 11001101 [0xA5] 2018.03.31 11:06 | Partition 1 | Armed special: quick-arm/auto-arm/keyswitch/wireless key/DLS
+   *  10100101 0 00010001 01101101 01100000 00101000 11100101 11111111 10001111 [0xA5] 2011.11.11 00:10 | Partition 1 | Auto-arm cancelled
+   *  10100101 0 00011000 01001111 11110111 01000000 11100110 11111111 00101000 [0xA5] 2018.03.31 23:16 | Partition 1 | Disarmed special: keyswitch/wireless key/DLS
+   *  10100101 0 00011000 01001111 01101111 01011100 11100111 11111111 10111101 [0xA5] 2018.03.27 15:23 | Partition 1 | Panel battery trouble
+   *  10100101 0 00011000 01001111 10110011 10011000 11101000 11111111 00111110 [0xA5] 2018.03.29 19:38 | Partition 1 | Panel AC power trouble
+   *  10100101 0 00011000 01001111 01110100 01010000 11101001 11111111 10111000 [0xA5] 2018.03.27 20:20 | Partition 1 | Bell trouble
+   *  10100101 0 00011000 01001111 11000000 10001000 11101100 11111111 00111111 [0xA5] 2018.03.30 00:34 | Partition 1 | Telephone line trouble
+   *  10100101 0 00011000 01001111 01101111 01110000 11101111 11111111 11011001 [0xA5] 2018.03.27 15:28 | Partition 1 | Panel battery restored
+   *  10100101 0 00011000 01010000 00100000 01011000 11110000 11111111 01110100 [0xA5] 2018.04.01 00:22 | Partition 1 | Panel AC power restored
+   *  10100101 0 00011000 01001111 01110100 01011000 11110001 11111111 11001000 [0xA5] 2018.03.27 20:22 | Partition 1 | Bell restored
+   *  10100101 0 00011000 01001111 11000000 10001000 11110100 11111111 01000111 [0xA5] 2018.03.30 00:34 | Partition 1 | Telephone line restored
+   *  10100101 0 00011000 01001111 11100001 01011000 11111111 11111111 01000011 [0xA5] 2018.03.31 01:22 | Partition 1 | System test
+   *  Byte 0   1    2        3        4        5        6        7        8
+   */
+  // 0x09 - 0x28: Zone alarm, zones 1-32
+  // 0x29 - 0x48: Zone alarm restored, zones 1-32
+  // 0x56 - 0x75: Zone tamper, zones 1-32
+  // 0x76 - 0x95: Zone tamper restored, zones 1-32
+  // 0x99 - 0xBD: Armed: Access codes 1-34, 40-42
+  // 0xC0 - 0xE4: Disarmed: Access codes 1-34, 40-42
+  if (printPanelText(panelStatus0, dscMessageCount(panelStatus0), panelByte)) return;
 
   /*
    *  Zone alarm, zones 1-32
@@ -506,43 +363,29 @@ void dscKeybusInterface::printPanelStatus0(byte panelByte) {
  *  select from multiple sets of status messages, split into printPanelStatus0...printPanelStatus3.
  */
 void dscKeybusInterface::printPanelStatus1(byte panelByte) {
-  switch (panelData[panelByte]) {
-    /*
-     *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
-     *  10100101 0 00011000 01001111 11001010 10001001 00000011 11111111 01100001 [0xA5] 2018.03.30 10:34 | Partition 1 | Cross zone alarm
-     *  10100101 0 00010001 01101101 01101010 00000001 00000100 11111111 10010001 [0xA5] 2011.11.11 10:00 | Partition 1 | Delinquency alarm
-     *  10100101 0 00010001 01101101 01100000 10101001 00100100 00000000 01010000 [0xA5] 2011.11.11 00:42 | Partition 1 | Duress code 33
-     *  10100101 0 00010001 01101101 01100000 10110101 00100101 00000000 01011101 [0xA5] 2011.11.11 00:45 | Partition 1 | Duress code 34
-     *  10100101 0 00010001 01101101 01100000 00101001 00100110 00000000 11010010 [0xA5] 2011.11.11 00:10 | Partition 1 | Master code 40
-     *  10100101 0 00010001 01101101 01100000 10010001 00100111 00000000 00111011 [0xA5] 2011.11.11 00:36 | Partition 1 | Supervisor code 41
-     *  10100101 0 00010001 01101101 01100000 10111001 00101000 00000000 01100100 [0xA5] 2011.11.11 00:46 | Partition 1 | Supervisor code 42
-     *  10100101 0 00011000 01001111 10100000 10011101 00101011 00000000 01110100 [0xA5] 2018.03.29 00:39 | Partition 1 | Armed: Auto-arm
-     *  10100101 0 00011000 01001101 00001010 00001101 10101100 00000000 11001101 [0xA5] 2018.03.08 10:03 | Partition 1 | Exit *8 programming
-     *  10100101 0 00011000 01001101 00001001 11100001 10101101 00000000 10100001 [0xA5] 2018.03.08 09:56 | Partition 1 | Enter *8 programming
-     *  10100101 0 00010001 01101101 01100010 11001101 11010000 00000000 00100010 [0xA5] 2011.11.11 02:51 | Partition 1 | Command output 4
-     *  10100101 0 00010110 01010110 00101011 11010001 11010010 00000000 11011111 [0xA5] 2016.05.17 11:52 | Partition 1 | Armed with no entry delay cancelled
-     *  Byte 0   1    2        3        4        5        6        7        8
-     */
-    case 0x03: stream->print(F("Cross zone alarm")); return;
-    case 0x04: stream->print(F("Delinquency alarm")); return;
-    case 0x05: stream->print(F("Late to close")); return;
-    // 0x24 - 0x28: Access codes 33-34, 40-42
-    case 0x29: stream->print(F("Downloading forced answer")); return;
-    case 0x2B: stream->print(F("Armed: Auto-arm")); return;
-    // 0x2C - 0x4B: Zone battery restored, zones 1-32
-    // 0x4C - 0x6B: Zone battery low, zones 1-32
-    // 0x6C - 0x8B: Zone fault restored, zones 1-32
-    // 0x8C - 0xAB: Zone fault, zones 1-32
-    case 0xAC: stream->print(F("Exit installer programming")); return;
-    case 0xAD: stream->print(F("Enter installer programming")); return;
-    case 0xAE: stream->print(F("Walk test end")); return;
-    case 0xAF: stream->print(F("Walk test begin")); return;
-    // 0xB0 - 0xCF: Zones bypassed, zones 1-32
-    case 0xD0: stream->print(F("Command output 4")); return;
-    case 0xD1: stream->print(F("Exit fault pre-alert")); return;
-    case 0xD2: stream->print(F("Armed: Entry delay")); return;
-    case 0xD3: stream->print(F("Downlook remote trigger")); return;
-  }
+  /*
+   *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
+   *  10100101 0 00011000 01001111 11001010 10001001 00000011 11111111 01100001 [0xA5] 2018.03.30 10:34 | Partition 1 | Cross zone alarm
+   *  10100101 0 00010001 01101101 01101010 00000001 00000100 11111111 10010001 [0xA5] 2011.11.11 10:00 | Partition 1 | Delinquency alarm
+   *  10100101 0 00010001 01101101 01100000 10101001 00100100 00000000 01010000 [0xA5] 2011.11.11 00:42 | Partition 1 | Duress code 33
+   *  10100101 0 00010001 01101101 01100000 10110101 00100101 00000000 01011101 [0xA5] 2011.11.11 00:45 | Partition 1 | Duress code 34
+   *  10100101 0 00010001 01101101 01100000 00101001 00100110 00000000 11010010 [0xA5] 2011.11.11 00:10 | Partition 1 | Master code 40
+   *  10100101 0 00010001 01101101 01100000 10010001 00100111 00000000 00111011 [0xA5] 2011.11.11 00:36 | Partition 1 | Supervisor code 41
+   *  10100101 0 00010001 01101101 01100000 10111001 00101000 00000000 01100100 [0xA5] 2011.11.11 00:46 | Partition 1 | Supervisor code 42
+   *  10100101 0 00011000 01001111 10100000 10011101 00101011 00000000 01110100 [0xA5] 2018.03.29 00:39 | Partition 1 | Armed: Auto-arm
+   *  10100101 0 00011000 01001101 00001010 00001101 10101100 00000000 11001101 [0xA5] 2018.03.08 10:03 | Partition 1 | Exit *8 programming
+   *  10100101 0 00011000 01001101 00001001 11100001 10101101 00000000 10100001 [0xA5] 2018.03.08 09:56 | Partition 1 | Enter *8 programming
+   *  10100101 0 00010001 01101101 01100010 11001101 11010000 00000000 00100010 [0xA5] 2011.11.11 02:51 | Partition 1 | Command output 4
+   *  10100101 0 00010110 01010110 00101011 11010001 11010010 00000000 11011111 [0xA5] 2016.05.17 11:52 | Partition 1 | Armed with no entry delay cancelled
+   *  Byte 0   1    2        3        4        5        6        7        8
+   */
+  // 0x24 - 0x28: Access codes 33-34, 40-42
+  // 0x2C - 0x4B: Zone battery restored, zones 1-32
+  // 0x4C - 0x6B: Zone battery low, zones 1-32
+  // 0x6C - 0x8B: Zone fault restored, zones 1-32
+  // 0x8C - 0xAB: Zone fault, zones 1-32
+  // 0xB0 - 0xCF: Zones bypassed, zones 1-32
+  if (printPanelText(panelStatus1, dscMessageCount(panelStatus1), panelByte)) return;
 
   /*
    *  Access codes 33-34, 40-42
@@ -639,54 +482,35 @@ void dscKeybusInterface::printPanelStatus1(byte panelByte) {
  *  select from multiple sets of status messages, split into printPanelStatus0...printPanelStatus3.
  */
 void dscKeybusInterface::printPanelStatus2(byte panelByte) {
-  switch (panelData[panelByte]) {
-
-    /*
-     *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
-     *  10100101 0 00011000 01001111 10101111 10000110 00101010 00000000 01101011 [0xA5] 2018.03.29 15:33 | Partition 1 | Quick exit
-     *  10100101 0 00010001 01101101 01110101 00111010 01100011 00000000 00110101 [0xA5] 2011.11.11 21:14 | Partition 1 | Keybus fault restored
-     *  10100101 0 00011000 01001111 11110111 01110110 01100110 00000000 11011111 [0xA5] 2018.03.31 23:29 | Partition 1 | Enter *1 zone bypass programming
-     *  10100101 0 00010001 01101101 01100010 11001110 01101001 00000000 10111100 [0xA5] 2011.11.11 02:51 | Partition 1 | Command output 3
-     *  10100101 0 00011000 01010000 01000000 00000010 10001100 00000000 11011011 [0xA5] 2018.04.02 00:00 | Partition 1 | Loss of system time
-     *  10100101 0 00011000 01001111 10101110 00001110 10001101 00000000 01010101 [0xA5] 2018.03.29 14:03 | Partition 1 | Power on
-     *  10100101 0 00011000 01010000 01000000 00000010 10001110 00000000 11011101 [0xA5] 2018.04.02 00:00 | Partition 1 | Panel factory default
-     *  10100101 0 00011000 01001111 11101010 10111010 10010011 00000000 01000011 [0xA5] 2018.03.31 10:46 | Partition 1 | Disarmed by keyswitch
-     *  10100101 0 00011000 01001111 11101010 10101110 10010110 00000000 00111010 [0xA5] 2018.03.31 10:43 | Partition 1 | Armed by keyswitch
-     *  10100101 0 00011000 01001111 10100000 01100010 10011000 00000000 10100110 [0xA5] 2018.03.29 00:24 | Partition 1 | Armed by quick-arm
-     *  10100101 0 00010001 01101101 01100000 00101110 10011001 00000000 01001010 [0xA5] 2011.11.11 00:11 | Partition 1 | Activate stay/away zones
-     *  10100101 0 00011000 01001111 00101101 00011010 10011010 00000000 11101101 [0xA5] 2018.03.25 13:06 | Partition 1 | Armed: stay
-     *  10100101 0 00011000 01001111 00101101 00010010 10011011 00000000 11100110 [0xA5] 2018.03.25 13:04 | Partition 1 | Armed: away
-     *  10100101 0 00011000 01001111 00101101 10011010 10011100 00000000 01101111 [0xA5] 2018.03.25 13:38 | Partition 1 | Armed with no entry delay
-     *  10100101 0 00011000 01001111 00101100 11011110 11000011 00000000 11011001 [0xA5] 2018.03.25 12:55 | Partition 1 | Enter *5 programming
-     *  10100101 0 00011000 01001111 00101110 00000010 11100110 00000000 00100010 [0xA5] 2018.03.25 14:00 | Partition 1 | Enter *6 programming
-     *  Byte 0   1    2        3        4        5        6        7        8
-     */
-    case 0x2A: stream->print(F("Quick exit")); return;
-    case 0x63: stream->print(F("Keybus fault restored")); return;
-    case 0x64: stream->print(F("Keybus fault")); return;
-    case 0x66: stream->print(F("*1: Zone bypass")); return;
-    // 0x67 - 0x69: *7: Command output 1-3
-    case 0x8C: stream->print(F("Cold start")); return;
-    case 0x8D: stream->print(F("Warm start")); return;
-    case 0x8E: stream->print(F("Panel factory default")); return;
-    case 0x91: stream->print(F("Swinger shutdown")); return;
-    case 0x93: stream->print(F("Disarmed: Keyswitch")); return;
-    case 0x96: stream->print(F("Armed: Keyswitch")); return;
-    case 0x97: stream->print(F("Armed: Keypad away")); return;
-    case 0x98: stream->print(F("Armed: Quick-arm")); return;
-    case 0x99: stream->print(F("Activate stay/away zones")); return;
-    case 0x9A: stream->print(F("Armed: Stay")); return;
-    case 0x9B: stream->print(F("Armed: Away")); return;
-    case 0x9C: stream->print(F("Armed: No entry delay")); return;
-    // 0x9E - 0xC2: *1: Access codes 1-34, 40-42
-    // 0xC3 - 0xC5: *5: Access codes 40-42
-    // 0xC6 - 0xE5: Access codes 1-34, 40-42
-    // 0xE6 - 0xE8: *6: Access codes 40-42
-    // 0xE9 - 0xF0: Keypad restored: Slots 1-8
-    // 0xF1 - 0xF8: Keypad trouble: Slots 1-8
-    // 0xF9 - 0xFE: Zone expander restored: 1-6
-    case 0xFF: stream->print(F("Zone expander trouble: 1")); return;
-  }
+  /*
+   *  Command    YYY1YYY2   MMMMDD DDDHHHHH MMMMMM    Status             CRC
+   *  10100101 0 00011000 01001111 10101111 10000110 00101010 00000000 01101011 [0xA5] 2018.03.29 15:33 | Partition 1 | Quick exit
+   *  10100101 0 00010001 01101101 01110101 00111010 01100011 00000000 00110101 [0xA5] 2011.11.11 21:14 | Partition 1 | Keybus fault restored
+   *  10100101 0 00011000 01001111 11110111 01110110 01100110 00000000 11011111 [0xA5] 2018.03.31 23:29 | Partition 1 | Enter *1 zone bypass programming
+   *  10100101 0 00010001 01101101 01100010 11001110 01101001 00000000 10111100 [0xA5] 2011.11.11 02:51 | Partition 1 | Command output 3
+   *  10100101 0 00011000 01010000 01000000 00000010 10001100 00000000 11011011 [0xA5] 2018.04.02 00:00 | Partition 1 | Loss of system time
+   *  10100101 0 00011000 01001111 10101110 00001110 10001101 00000000 01010101 [0xA5] 2018.03.29 14:03 | Partition 1 | Power on
+   *  10100101 0 00011000 01010000 01000000 00000010 10001110 00000000 11011101 [0xA5] 2018.04.02 00:00 | Partition 1 | Panel factory default
+   *  10100101 0 00011000 01001111 11101010 10111010 10010011 00000000 01000011 [0xA5] 2018.03.31 10:46 | Partition 1 | Disarmed by keyswitch
+   *  10100101 0 00011000 01001111 11101010 10101110 10010110 00000000 00111010 [0xA5] 2018.03.31 10:43 | Partition 1 | Armed by keyswitch
+   *  10100101 0 00011000 01001111 10100000 01100010 10011000 00000000 10100110 [0xA5] 2018.03.29 00:24 | Partition 1 | Armed by quick-arm
+   *  10100101 0 00010001 01101101 01100000 00101110 10011001 00000000 01001010 [0xA5] 2011.11.11 00:11 | Partition 1 | Activate stay/away zones
+   *  10100101 0 00011000 01001111 00101101 00011010 10011010 00000000 11101101 [0xA5] 2018.03.25 13:06 | Partition 1 | Armed: stay
+   *  10100101 0 00011000 01001111 00101101 00010010 10011011 00000000 11100110 [0xA5] 2018.03.25 13:04 | Partition 1 | Armed: away
+   *  10100101 0 00011000 01001111 00101101 10011010 10011100 00000000 01101111 [0xA5] 2018.03.25 13:38 | Partition 1 | Armed with no entry delay
+   *  10100101 0 00011000 01001111 00101100 11011110 11000011 00000000 11011001 [0xA5] 2018.03.25 12:55 | Partition 1 | Enter *5 programming
+   *  10100101 0 00011000 01001111 00101110 00000010 11100110 00000000 00100010 [0xA5] 2018.03.25 14:00 | Partition 1 | Enter *6 programming
+   *  Byte 0   1    2        3        4        5        6        7        8
+   */
+  // 0x67 - 0x69: *7: Command output 1-3
+  // 0x9E - 0xC2: *1: Access codes 1-34, 40-42
+  // 0xC3 - 0xC5: *5: Access codes 40-42
+  // 0xC6 - 0xE5: Access codes 1-34, 40-42
+  // 0xE6 - 0xE8: *6: Access codes 40-42
+  // 0xE9 - 0xF0: Keypad restored: Slots 1-8
+  // 0xF1 - 0xF8: Keypad trouble: Slots 1-8
+  // 0xF9 - 0xFE: Zone expander restored: 1-6
+  if (printPanelText(panelStatus2, dscMessageCount(panelStatus2), panelByte)) return;
 
   /*
    *  *7: Command output 1-3
@@ -800,33 +624,11 @@ void dscKeybusInterface::printPanelStatus2(byte panelByte) {
  *  Byte 0   1    2        3        4        5        6        7        8
  */
 void dscKeybusInterface::printPanelStatus3(byte panelByte) {
-  switch (panelData[panelByte]) {
-    case 0x05: stream->print(F("PC/RF5132: Supervisory restored")); return;
-    case 0x06: stream->print(F("PC/RF5132: Supervisory trouble")); return;
-    case 0x09: stream->print(F("PC5204: Supervisory restored")); return;
-    case 0x0A: stream->print(F("PC5204: Supervisory trouble")); return;
-    case 0x17: stream->print(F("Zone expander restored: 7")); return;
-    case 0x18: stream->print(F("Zone expander trouble: 7")); return;
-    // 0x25 - 0x2C: Keypad tamper restored, slots 1-8
-    // 0x2D - 0x34: Keypad tamper, slots 1-8
-    // 0x35 - 0x3A: Module tamper restored, slots 9-14
-    // 0x3B - 0x40: Module tamper, slots 9-14
-    case 0x41: stream->print(F("PC/RF5132: Tamper restored")); return;
-    case 0x42: stream->print(F("PC/RF5132: Tamper")); return;
-    case 0x43: stream->print(F("PC5208: Tamper restored")); return;
-    case 0x44: stream->print(F("PC5208: Tamper")); return;
-    case 0x45: stream->print(F("PC5204: Tamper restored")); return;
-    case 0x46: stream->print(F("PC5204: Tamper")); return;
-    case 0x51: stream->print(F("Zone expander tamper restored: 7")); return;
-    case 0x52: stream->print(F("Zone expander tamper: 7")); return;
-    case 0xB3: stream->print(F("PC5204: Battery restored")); return;
-    case 0xB4: stream->print(F("PC5204: Battery trouble")); return;
-    case 0xB5: stream->print(F("PC5204: Aux supply restored")); return;
-    case 0xB6: stream->print(F("PC5204: Aux supply trouble")); return;
-    case 0xB7: stream->print(F("PC5204: Output 1 restored")); return;
-    case 0xB8: stream->print(F("PC5204: Output 1 trouble")); return;
-    case 0xFF: stream->print(F("Extended status")); return;
-  }
+  // 0x25 - 0x2C: Keypad tamper restored, slots 1-8
+  // 0x2D - 0x34: Keypad tamper, slots 1-8
+  // 0x35 - 0x3A: Module tamper restored, slots 9-14
+  // 0x3B - 0x40: Module tamper, slots 9-14
+  if (printPanelText(panelStatus3, dscMessageCount(panelStatus3), panelByte)) return;
 
   /*
    *  Zone expander trouble: 2-6
@@ -906,11 +708,7 @@ void dscKeybusInterface::printPanelStatus3(byte panelByte) {
  *  Byte 0   1    2        3        4        5        6        7        8        9        10
  */
 void dscKeybusInterface::printPanelStatus4(byte panelByte) {
-  switch (panelData[panelByte]) {
-    case 0x86: stream->print(F("Periodic test with trouble")); return;
-    case 0x87: stream->print(F("Exit fault")); return;
-    case 0x89: stream->print(F("Alarm cancelled")); return;
-  }
+  if (printPanelText(panelStatus4, dscMessageCount(panelStatus4), panelByte)) return;
 
   if (panelData[panelByte] <= 0x1F) {
     stream->print("Zone alarm: ");
@@ -986,12 +784,7 @@ void dscKeybusInterface::printPanelStatus5(byte panelByte) {
  */
 void dscKeybusInterface::printPanelStatus14(byte panelByte) {
   #if !defined(__AVR__)  // Excludes Arduino/AVR to conserve storage space
-  switch (panelData[panelByte]) {
-    case 0xC0: stream->print(F("TLink com fault")); return;
-    case 0xC2: stream->print(F("Tlink network fault")); return;
-    case 0xC4: stream->print(F("TLink receiver trouble")); return;
-    case 0xC5: stream->print(F("TLink receiver restored")); return;
-  }
+  if (printPanelText(panelStatus14, dscMessageCount(panelStatus14), panelByte)) return;
   #endif
 
   printUnknownData();
@@ -1008,11 +801,7 @@ void dscKeybusInterface::printPanelStatus14(byte panelByte) {
  *  from multiple sets of status messages, split into printPanelStatus4...printPanelStatus1B.
  */
 void dscKeybusInterface::printPanelStatus16(byte panelByte) {
-  switch (panelData[panelByte]) {
-    case 0x80: stream->print(F("Trouble acknowledged")); return;
-    case 0x81: stream->print(F("RF delinquency trouble")); return;
-    case 0x82: stream->print(F("RF delinquency restore")); return;
-  }
+  if (printPanelText(panelStatus16, dscMessageCount(panelStatus16), panelByte)) return;
 
   printUnknownData();
 }
@@ -1145,9 +934,7 @@ void dscKeybusInterface::printPanelStatus18(byte panelByte) {
  *  from multiple sets of status messages, split into printPanelStatus4...printPanelStatus1B.
  */
 void dscKeybusInterface::printPanelStatus1B(byte panelByte) {
-  switch (panelData[panelByte]) {
-    case 0xF1: stream->print(F("System reset transmission")); return;
-  }
+  if (printPanelText(panelStatus1B, dscMessageCount(panelStatus1B), panelByte)) return;
 
   printUnknownData();
 }
@@ -2257,19 +2044,6 @@ void dscKeybusInterface::printPanel_0xD5() {
  *  Byte 2: Subcommand
  */
 void dscKeybusInterface::printPanel_0xE6() {
-  switch (panelData[2]) {
-    case 0x08:
-    case 0x0A:
-    case 0x0C:
-    case 0x0E: break;  // Skips panel commands without CRC data
-    default: {         // Checks remaining panel commands
-      if (!validCRC()) {
-        stream->print(F("[CRC Error]"));
-        return;
-      }
-    }
-  }
-
   switch (panelData[2]) {
     case 0x01:
     case 0x02:
@@ -3659,6 +3433,12 @@ void dscKeybusInterface::printModule_KeyCodes(byte keyByte) {
 
 /*
  *  Zone expander zone status module response for panel commands: 0x22, 0x28, 0x33, 0x39, 0xE6.8, 0xE6.A, 0xE6.C, 0xE6.E
+ *
+ *  Byte 2 (0xE6: byte 3): Zones 1-4, 2 bits per zone starting from bits 0-1 - 0: open, 1: closed, 2: tamper, 3: open (D/EOL)
+ *  Byte 3 (0xE6: byte 4): Zones 1-4 previous state
+ *  Byte 4 (0xE6: byte 5): Zones 5-8
+ *  Byte 5 (0xE6: byte 6): Zones 5-8 previous state
+ *  Byte 6 (0xE6: byte 7) bit 4-7: Checksum, sum of the inverted nibbles of bytes 2-5
  */
 void dscKeybusInterface::printModule_Expander() {
   byte startByte = 2;
@@ -3719,15 +3499,7 @@ bool dscKeybusInterface::printModuleSlots(byte outputNumber, byte startByte, byt
     for (byte testMask = startMask; testMask != 0; testMask >>= bitShift) {
       if (testByte == endByte && testMask < endMask) return false;
 
-      byte testData = moduleData[testByte];
-
-      // Reverses the bit order
-      if (reverse) {
-        testData = 0;
-        for (byte i = 0; i < 8; i++) testData |= ((moduleData[testByte] >> i) & 1) << (7 - i);
-      }
-
-      if ((testData & testMask) >> matchShift == matchValue) {
+      if (moduleSlotMatch(testByte, testMask, matchShift, matchValue, reverse)) {
         if (outputNumber == 255) return true;
         else printNumberSpace(outputNumber);
       }
@@ -3784,24 +3556,18 @@ void dscKeybusInterface::printPanelPartitionStatus(byte startPartition, byte sta
  *  Structure decoding: complete
  *  Content decoding: complete
  */
-void dscKeybusInterface::printPanelTime(byte panelByte) {
-  byte dscYear3 = panelData[panelByte] >> 4;
-  byte dscYear4 = panelData[panelByte] & 0x0F;
-  byte dscMonth = panelData[panelByte + 1] << 2; dscMonth >>= 4;
-  byte dscDay1 = panelData[panelByte + 1] << 6; dscDay1 >>= 3;
-  byte dscDay2 = panelData[panelByte + 2] >> 5;
-  byte dscDay = dscDay1 | dscDay2;
-  byte dscHour = panelData[panelByte + 2] & 0x1F;
-  byte dscMinute = panelData[panelByte + 3] >> 2;
-
-  if (dscYear3 >= 7) stream->print(F("19"));
+void dscKeybusInterface::printPanelTime(byte panelByte, char dateSeparator) {
+  byte dscYear, dscMonth, dscDay, dscHour, dscMinute;
+  decodePanelTime(panelByte, dscYear, dscMonth, dscDay, dscHour, dscMinute);
+
+  if (dscYear >= 70) stream->print(F("19"));
   else stream->print(F("20"));
-  stream->print(dscYear3);
-  stream->print(dscYear4, HEX);
-  stream->print(".");
+  if (dscYear < 10) stream->print("0");
+  stream->print(dscYear);
+  stream->print(dateSeparator);
   if (dscMonth < 10) stream->print("0");
   stream->print(dscMonth);
-  stream->print(".");
+  stream->print(dateSeparator);
   if (dscDay < 10) stream->print("0");
   stream->print(dscDay);
   stream->print(" ");
@@ -3955,6 +3721,24 @@ void dscKeybusInterface::printNumberOffset(byte panelByte, int numberOffset) {
 }
 
 
+// Prints the message text for the status code from a PROGMEM table sorted by code, returns false if not found
+bool dscKeybusInterface::printPanelText(const dscMessage messages[], byte messageCount, byte panelByte) {
+  byte lowIndex = 0;
+  byte highIndex = messageCount;
+  while (lowIndex < highIndex) {
+    byte messageIndex = (lowIndex + highIndex) / 2;
+    byte messageCode = pgm_read_byte(&messages[messageIndex].code);
+    if (messageCode == panelData[panelByte]) {
+      stream->print((const __FlashStringHelper *) pgm_read_ptr(&messages[messageIndex].text));
+      return true;
+    }
+    if (messageCode < panelData[panelByte]) lowIndex = messageIndex + 1;
+    else highIndex = messageIndex;
+  }
+  return false;
+}
+
+
 // Prints individual bits as a number for partitions and zones
 void dscKeybusInterface::printPanelBitNumbers(byte panelByte, byte startNumber, byte startBit, byte stopBit, bool printNone) {
   if (printNone && panelData[panelByte] == 0) stream->print(F("none "));
@@ -3999,11 +3783,7 @@ void dscKeybusInterface::printPanelBinary(bool printSpaces) {
 void dscKeybusInterface::printModuleBinary(bool printSpaces) {
   for (byte moduleByte = 0; moduleByte < moduleByteCount; moduleByte++) {
     if (moduleByte == 1) stream->print(moduleData[moduleByte]);  // Prints the stop bit
-    else if (hideKeypadDigits
-            && (moduleByte == 2 || moduleByte == 3 || moduleByte == 8 || moduleByte == 9)
-            && (moduleData[2] <= 0x27 || moduleData[3] <= 0x27 || moduleData[8] <= 0x27 || moduleData[9] <= 0x27)
-            && !queryResponse)
-              stream->print(F("........"));  // Hides keypad digits
+    else if (hiddenModuleByte(moduleByte)) stream->print(F("........"));  // Hides keypad digits
     else {
       for (byte mask = 0x80; mask; mask >>= 1) {
         if (mask & moduleData[moduleByte]) stream->print("1");
@@ -4036,3 +3816,45 @@ void dscKeybusInterface::printPanelCommand() {
     stream->print(panelData[2], HEX);
   }
 }
+
+
+// Checks if the current panel command includes CRC data
+bool dscKeybusInterface::panelCRC() {
+  switch (panelData[0]) {
+    case 0x05:
+    case 0x11:
+    case 0x1B:
+    case 0x1C:
+    case 0x22:
+    case 0x28:
+    case 0x33:
+    case 0x39:
+    case 0x41:
+    case 0x4C:
+    case 0x57:
+    case 0x58:
+    case 0x70:
+    case 0x94:
+    case 0x9E:
+    case 0xD5: return false;
+    case 0xE6: {
+      switch (panelData[2]) {
+        case 0x08:
+        case 0x0A:
+        case 0x0C:
+        case 0x0E: return false;
+      }
+      return true;
+    }
+    default: return true;
+  }
+}
+
+
+// Checks if a module byte contains keypad digits hidden by hideKeypadDigits
+bool dscKeybusInterface::hiddenModuleByte(byte moduleByte) {
+  return hideKeypadDigits
+         && (moduleByte == 2 || moduleByte == 3 || moduleByte == 8 || moduleByte == 9)
+         && (moduleData[2] <= 0x27 || moduleData[3] <= 0x27 || moduleData[8] <= 0x27 || moduleData[9] <= 0x27)
+         && !queryResponse;
+}
@@ -0,0 +1,232 @@
+/*
+    DSC Keybus Interface
+
+    Functions used by the KeybusReader sketch to output Keybus data in machine-readable formats for log
+    processing: one JSON object per message (JSON lines), or a compact length-prefixed binary frame.
+
+    https://github.com/taligentx/dscKeybusInterface
+
+    JSON example:
+      {"time":12345,"type":"panel","cmd":"0x05","bits":41,"crc":"none","data":"0500810181C7","partitions":[{"partition":1,"lights":"0x81","status":"0x01"},...]}
+      {"time":12352,"type":"module","cmd":"0x05","bits":41,"data":"05FFFFFFBFFF"}
+
+    Binary frame:
+      Byte 0: Frame length, excluding byte 0
+      Byte 1: Frame type - 0x01: panel, 0x02: module
+      Byte 2-5: Timestamp in milliseconds, least significant byte first
+      Byte 6: Bit count
+      Byte 7: Panel frames: CRC status - 0: no CRC, 1: valid, 2: error | Module frames: panel command
+      Byte 8+: panelData[] or moduleData[], up to the byte count - hidden keypad digits are set to 0xFF
+
+    This library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dscKeybus.h"
+
+
+// Prints the panel message as a single line JSON object
+void dscKeybusInterface::printPanelJSON() {
+  bool crcData = panelCRC();
+  bool crcValid = crcData && validCRC();
+
+  stream->print(F("{\"time\":"));
+  stream->print(millis());
+  stream->print(F(",\"type\":\"panel\",\"cmd\":\"0x"));
+  printJSONHex(panelData[0]);
+  if (panelData[0] == 0xE6) {
+    stream->print(F("\",\"sub\":\"0x"));
+    printJSONHex(panelData[2]);
+  }
+  stream->print(F("\",\"bits\":"));
+  stream->print(panelBitCount);
+  stream->print(F(",\"crc\":\""));
+  if (!crcData) stream->print(F("none"));
+  else if (crcValid) stream->print(F("valid"));
+  else stream->print(F("error"));
+  stream->print(F("\",\"data\":\""));
+  for (byte panelByte = 0; panelByte < panelByteCount; panelByte++) printJSONHex(panelData[panelByte]);
+  stream->print("\"");
+
+  // Decodes fields only from complete data
+  if (!crcData || crcValid) {
+    switch (panelData[0]) {
+      case 0x05: printJSONPartitions(1, 2, (panelByteCount - 2) / 2); break;
+      case 0x0A: printJSONPartitions(1, 2, 1); break;
+      case 0x0F: printJSONPartitions(2, 2, 1); break;
+      case 0x1B: printJSONPartitions(5, 2, (panelByteCount - 2) / 2); break;
+      case 0x27: printJSONPartitions(1, 2, 2); printJSONZones(6, 1); break;
+      case 0x2D: printJSONPartitions(1, 2, 2); printJSONZones(6, 9); break;
+      case 0x34: printJSONPartitions(1, 2, 2); printJSONZones(6, 17); break;
+      case 0x3E: printJSONPartitions(1, 2, 2); printJSONZones(6, 25); break;
+      case 0x87: {
+        stream->print(F(",\"pgm\":\"0x"));
+        printJSONHex(panelData[2]);
+        printJSONHex(panelData[3]);
+        stream->print("\"");
+        break;
+      }
+      case 0xA5:
+      case 0xAA: {
+        printJSONTime(2);
+        stream->print(F(",\"partition\":"));
+        stream->print(panelData[3] >> 6);
+        printJSONStatus(panelData[5] & 0x03, 6);
+        if (panelData[0] == 0xAA) {
+          stream->print(F(",\"event\":"));
+          stream->print(panelData[7]);
+        }
+        break;
+      }
+      case 0xEB:
+      case 0xEC: {
+        printJSONTime(3);
+        stream->print(F(",\"partitions\":\"0x"));
+        printJSONHex(panelData[2]);
+        stream->print("\"");
+        printJSONStatus(panelData[7], 8);
+        if (panelData[0] == 0xEC) {
+          stream->print(F(",\"event\":"));
+          stream->print(panelData[9] + ((panelData[4] >> 6) * 256));
+        }
+        break;
+      }
+      case 0xE6: {
+        switch (panelData[2]) {
+          case 0x09: printJSONZones(3, 33); break;
+          case 0x0B: printJSONZones(3, 41); break;
+          case 0x0D: printJSONZones(3, 49); break;
+          case 0x0F: printJSONZones(3, 57); break;
+        }
+        break;
+      }
+    }
+  }
+
+  stream->print("}");
+}
+
+
+// Prints the keypad or module message as a single line JSON object
+void dscKeybusInterface::printModuleJSON() {
+  stream->print(F("{\"time\":"));
+  stream->print(millis());
+  stream->print(F(",\"type\":\"module\",\"cmd\":\"0x"));
+  printJSONHex(moduleCmd);
+  if (moduleCmd == 0xE6) {
+    stream->print(F("\",\"sub\":\"0x"));
+    printJSONHex(moduleSubCmd);
+  }
+  stream->print(F("\",\"bits\":"));
+  stream->print(moduleBitCount);
+  stream->print(F(",\"data\":\""));
+  for (byte moduleByte = 0; moduleByte < moduleByteCount; moduleByte++) {
+    if (hiddenModuleByte(moduleByte)) stream->print("..");
+    else printJSONHex(moduleData[moduleByte]);
+  }
+  stream->print(F("\",\"query\":"));
+  if (queryResponse) stream->print(F("true}"));
+  else stream->print(F("false}"));
+}
+
+
+// Writes the panel message as a length-prefixed binary frame
+void dscKeybusInterface::printPanelFrame() {
+  byte crcStatus = 0;
+  if (panelCRC()) {
+    if (validCRC()) crcStatus = 1;
+    else crcStatus = 2;
+  }
+
+  printFrameHeader(0x01, panelByteCount, panelBitCount, crcStatus);
+  for (byte panelByte = 0; panelByte < panelByteCount; panelByte++) stream->write(panelData[panelByte]);
+}
+
+
+// Writes the keypad or module message as a length-prefixed binary frame
+void dscKeybusInterface::printModuleFrame() {
+  printFrameHeader(0x02, moduleByteCount, moduleBitCount, moduleCmd);
+  for (byte moduleByte = 0; moduleByte < moduleByteCount; moduleByte++) {
+    if (hiddenModuleByte(moduleByte)) stream->write(0xFF);
+    else stream->write(moduleData[moduleByte]);
+  }
+}
+
+
+void dscKeybusInterface::printFrameHeader(byte frameType, byte byteCount, byte bitCount, byte frameInfo) {
+  unsigned long frameTime = millis();
+  stream->write(byteCount + 7);
+  stream->write(frameType);
+  for (byte i = 0; i < 4; i++) stream->write((byte)(frameTime >> (i * 8)));
+  stream->write(bitCount);
+  stream->write(frameInfo);
+}
+
+
+void dscKeybusInterface::printJSONHex(byte value) {
+  if (value < 16) stream->print("0");
+  stream->print(value, HEX);
+}
+
+
+// Prints the lights and status message bytes for each partition
+void dscKeybusInterface::printJSONPartitions(byte startPartition, byte startByte, byte partitionCount) {
+  if (partitionCount > 4) partitionCount = 4;
+
+  stream->print(F(",\"partitions\":["));
+  for (byte partitionIndex = 0; partitionIndex < partitionCount; partitionIndex++) {
+    byte lightsByte = startByte + (partitionIndex * 2);
+    if (partitionIndex > 0) stream->print(",");
+    stream->print(F("{\"partition\":"));
+    stream->print(startPartition + partitionIndex);
+    stream->print(F(",\"lights\":\"0x"));
+    printJSONHex(panelData[lightsByte]);
+    stream->print(F("\",\"status\":\"0x"));
+    printJSONHex(panelData[lightsByte + 1]);
+    stream->print("\"}");
+  }
+  stream->print("]");
+}
+
+
+// Prints the open zones in a zone status byte as an array of zone numbers
+void dscKeybusInterface::printJSONZones(byte panelByte, byte startZone) {
+  stream->print(F(",\"openZones\":["));
+  bool firstZone = true;
+  for (byte zoneBit = 0; zoneBit < 8; zoneBit++) {
+    if (bitRead(panelData[panelByte], zoneBit)) {
+      if (!firstZone) stream->print(",");
+      stream->print(startZone + zoneBit);
+      firstZone = false;
+    }
+  }
+  stream->print("]");
+}
+
+
+// Prints the status message set and code, decoded as text by printPanelStatus0()...printPanelStatus1B()
+void dscKeybusInterface::printJSONStatus(byte statusSet, byte panelByte) {
+  stream->print(F(",\"statusSet\":\"0x"));
+  printJSONHex(statusSet);
+  stream->print(F("\",\"statusCode\":\"0x"));
+  printJSONHex(panelData[panelByte]);
+  stream->print("\"");
+}
+
+
+// Prints the panel date and time as "YYYY-MM-DD HH:MM"
+void dscKeybusInterface::printJSONTime(byte panelByte) {
+  stream->print(F(",\"panelTime\":\""));
+  printPanelTime(panelByte, '-');
+  stream->print("\"");
+}
@@ -52,71 +52,451 @@ void dscKeybusInterface::resetStatus() {
   }
   pgmOutputsChanged[0] = 0xFF;
   pgmOutputsChanged[1] = 0x3F;
+  timeChanged = true;
+  communicationChanged = true;
+  for (byte partition = 0; partition < dscPartitions; partition++) {
+    lightsFlashingChanged[partition] = true;
+    enabledZonesChanged[partition] = true;
+  }
+  flashingZonesStatusChanged = true;
+  programZonesStatusChanged = true;
+  for (byte zoneGroup = 0; zoneGroup < dscZones; zoneGroup++) {
+    flashingZonesChanged[zoneGroup] = 0xFF;
+    programZonesChanged[zoneGroup] = 0xFF;
+  }
+  moduleSlotsChanged = true;
 }
 
 
-// Sets the panel time
-bool dscKeybusInterface::setTime(unsigned int year, byte month, byte day, byte hour, byte minute, const char* accessCode, byte timePartition) {
+// Sets the panel time by buffering the time entry keys for loop()
+byte dscKeybusInterface::setTime(unsigned int year, byte month, byte day, byte hour, byte minute, const char* accessCode, byte timePartition) {
+  if (timePartition == 0 || timePartition > dscPartitions) return 0;
+  if (!ready[timePartition - 1]) return 0;  // Skips if the time partition is not ready
+  if (hour > 23 || minute > 59 || month > 12 || day > 31 || year > 2099 || (year > 99 && year < 1900)) return 0;  // Skips if input date/time is invalid
+  if (strlen(accessCode) > 6) return 0;
 
-  // Loops if a previous write is in progress
-  while(writeKeyPending || writeKeysPending) {
-    loop();
-    #if defined(ESP8266)
-    yield();
-    #endif
+  if (year >= 2000) year -= 2000;
+  else if (year >= 1900) year -= 1900;
+
+  // Builds the time entry: *6 [access code] 1 HH MM mm DD YY #
+  char timeEntry[21] = "*6";
+  byte entryIndex = 2;
+  while (*accessCode) timeEntry[entryIndex++] = *accessCode++;
+  timeEntry[entryIndex++] = '1';
+  byte timeDigits[] = {hour, minute, month, day, (byte)year};
+  for (byte i = 0; i < 5; i++) {
+    timeEntry[entryIndex++] = '0' + (timeDigits[i] / 10);
+    timeEntry[entryIndex++] = '0' + (timeDigits[i] % 10);
   }
+  timeEntry[entryIndex++] = '#';
+  timeEntry[entryIndex] = '\0';
+
+  // Keys are written by loop() to the time partition without changing writePartition
+  return bufferKeys(timeEntry, timePartition);
+}
 
-  if (!ready[0]) return false;  // Skips if partition 1 is not ready
 
-  if (hour > 23 || minute > 59 || month > 12 || day > 31 || year > 2099 || (year > 99 && year < 1900)) return false;  // Skips if input date/time is invalid
-  static char timeEntry[21];
-  strcpy(timeEntry, "*6");
-  strcat(timeEntry, accessCode);
-  strcat(timeEntry, "1");
+// Compares the time with the panel time, estimated from the last panel timestamp and the time since it was received.
+// Returns true if the difference is more than maxDrift minutes or if the panel has not yet sent the time.
+bool dscKeybusInterface::timeSyncRequired(unsigned int year, byte month, byte day, byte hour, byte minute, byte maxDrift) {
+  if (!timeReceived) return true;
 
-  char timeChar[3];
-  if (hour < 10) strcat(timeEntry, "0");
-  itoa(hour, timeChar, 10);
-  strcat(timeEntry, timeChar);
+  unsigned long panelMinutes = timeMinutes + ((millis() - timeReceivedTime) / 60000);
+  timeDrift = (long)(dateMinutes(year, month, day, hour, minute) - panelMinutes);
+  if (timeDrift > maxDrift || timeDrift < -maxDrift) return true;
+  return false;
+}
 
-  if (minute < 10) strcat(timeEntry, "0");
-  itoa(minute, timeChar, 10);
-  strcat(timeEntry, timeChar);
 
-  if (month < 10) strcat(timeEntry, "0");
-  itoa(month, timeChar, 10);
-  strcat(timeEntry, timeChar);
+// Converts a date and time to minutes from a fixed epoch for comparing times
+unsigned long dscKeybusInterface::dateMinutes(unsigned int year, byte month, byte day, byte hour, byte minute) {
+  if (year < 100) year += 2000;
+  if (month < 3) {
+    year--;
+    month += 12;
+  }
+  unsigned long days = (365UL * year) + (year / 4) - (year / 100) + (year / 400) + (((153 * (month - 3)) + 2) / 5) + day;
+  return (((days * 24) + hour) * 60) + minute;
+}
 
-  if (day < 10) strcat(timeEntry, "0");
-  itoa(day, timeChar, 10);
-  strcat(timeEntry, timeChar);
 
-  if (year >= 2000) year -= 2000;
-  else if (year >= 1900) year -= 1900;
-  if (year < 10) strcat(timeEntry, "0");
-  itoa(year, timeChar, 10);
-  strcat(timeEntry, timeChar);
+// Starts downloading the event buffer for a partition
+bool dscKeybusInterface::downloadEvents(byte eventPartition, unsigned int maxEvents) {
+  if (downloadingEvents || !writeReady || !virtualKeypad) return false;
+  if (eventPartition == 0 || eventPartition > dscPartitions || maxEvents == 0) return false;
+
+  eventKeyPartition = eventPartition;
+  eventTotal = 0;
+  eventMax = maxEvents;
+  eventRetries = 0;
+  eventFinishing = false;
+  eventKey = 'b';  // Enters the event buffer, the panel responds with the most recent event
+  eventLastKey = eventKey;
+  downloadingEvents = true;
+  writeReady = false;
+  return true;
+}
+
+
+// Starts a virtual keypad macro on a partition
+bool dscKeybusInterface::runMacro(const dscMacroStep steps[], byte stepCount, byte stepPartition) {
+  if (macroRunning || !writeReady || !virtualKeypad) return false;
+  if (stepPartition == 0 || stepPartition > dscPartitions || stepCount == 0) return false;
+
+  macroSteps = steps;
+  macroStepCount = stepCount;
+  macroPartition = stepPartition;
+  macroStep = 0;
+  macroState = 0;
+  macroHandle = 0;
+  macroTime = millis();
+  macroRunning = true;
+  writeReady = false;
+  return true;
+}
+
+
+void dscKeybusInterface::stopMacro() {
+  if (macroRunning) endMacro(DSC_MACRO_ABORTED);
+}
+
+
+// Runs the current macro step, called by loop()
+void dscKeybusInterface::processMacro() {
+  const dscMacroStep *step = &macroSteps[macroStep];
+  byte partitionIndex = macroPartition - 1;
+
+  // Stops the macro if an abort guard is met at any point in the step
+  if (((step->guards & DSC_MACRO_ABORT_ALARM) && alarm[partitionIndex]) || ((step->guards & DSC_MACRO_ABORT_ARMED) && armed[partitionIndex])) {
+    endMacro(DSC_MACRO_ABORTED);
+    return;
+  }
+
+  switch (macroState) {
+
+    // Waits for the step guards and buffers the step keys
+    case 0: {
+      bool guardsMet = true;
+      if ((step->guards & DSC_MACRO_WAIT_READY) && !ready[partitionIndex]) guardsMet = false;
+      if ((step->guards & DSC_MACRO_WAIT_ARMED) && !armed[partitionIndex]) guardsMet = false;
+      if ((step->guards & DSC_MACRO_WAIT_DISARMED) && armed[partitionIndex]) guardsMet = false;
+      if ((step->guards & DSC_MACRO_WAIT_PROMPT) && !accessCodePrompt) guardsMet = false;
+      if (!guardsMet) {
+        if (millis() - macroTime > macroTimeout) endMacro(DSC_MACRO_TIMEOUT);
+        return;
+      }
+
+      if (step->keys != NULL && step->keys[0] != '\0') {
+        macroHandle = bufferKeys(step->keys, macroPartition);
+        if (macroHandle == 0) return;  // Retries if the key buffer is full
+      }
+      macroState = 1;
+      break;
+    }
+
+    // Waits until the step keys are written and acknowledged by the panel
+    case 1: {
+      if (macroHandle != 0 && !writeComplete(macroHandle)) return;
+      macroHandle = 0;
+      macroTime = millis();
+      macroState = 2;
+      break;
+    }
+
+    // Waits for the step delay and starts the next step
+    case 2: {
+      if (millis() - macroTime < step->delay) return;
+      macroStep++;
+      if (macroStep >= macroStepCount) {
+        macroStep = macroStepCount - 1;
+        endMacro(DSC_MACRO_COMPLETE);
+      }
+      else {
+        macroState = 0;
+        macroTime = millis();
+      }
+      break;
+    }
+  }
+}
+
+
+// Stops the macro and removes keys from the key buffer that have not been written
+void dscKeybusInterface::endMacro(byte result) {
+  if (macroHandle != 0) {
+    byte keyPosition = keyBufferIndex;
+    for (byte i = 0; i < keyBufferLength; i++) {
+      if (keyBuffer[keyPosition] != 0 && keyBufferHandle[keyPosition] == macroHandle) {
+        keyBuffer[keyPosition] = 0;
+        processWriteKey(macroHandle, 0xFF);
+      }
+      keyPosition++;
+      if (keyPosition >= dscKeyBufferSize) keyPosition = 0;
+    }
+    macroHandle = 0;
+  }
+
+  macroRunning = false;
+  macroResult = result;
+  macroChanged = true;
+  if (!pauseStatus) statusChanged = true;
+}
+
+
+// Copies the next downloaded event to bufferEvent
+bool dscKeybusInterface::handleEvent() {
+  if (eventCount == 0) return false;
+
+  bufferEvent = events[eventIndex];
+  eventIndex++;
+  if (eventIndex >= dscEventBufferSize) eventIndex = 0;
+  eventCount--;
+  return true;
+}
+
+
+// Sends the next event buffer key as soon as the previous event is received, called by loop()
+void dscKeybusInterface::processEventDownload() {
+  if (writeKeysPending() || keyBufferLength > 0) return;
+
+  // Completes the download after the exit key is written
+  if (eventFinishing) {
+    downloadingEvents = false;
+    eventFinishing = false;
+    return;
+  }
+
+  if (eventKey != 0) {
+    if (eventKey == '<' && eventCount >= dscEventBufferSize) return;  // Waits until handleEvent() frees space for the next event
+
+    char eventKeys[2] = {eventKey, '\0'};
+    if (bufferKeys(eventKeys, eventKeyPartition) == 0) return;
+    if (eventKey == '#') eventFinishing = true;
+    eventLastKey = eventKey;
+    eventKey = 0;
+    eventRequestTime = millis();
+    return;
+  }
 
-  strcat(timeEntry, "#");
+  // Repeats the key if the panel does not respond, and exits the event buffer after repeated timeouts
+  if (millis() - eventRequestTime > 3000) {
+    if (eventRetries < 2) {
+      eventRetries++;
+      eventKey = eventLastKey;
+    }
+    else eventKey = '#';
+  }
+}
+
+
+/*
+ *  Event buffer entries from 0xAA (partitions 1-2) and 0xEC (partitions 1-8) are stored as dscEvent in events[]
+ *  while downloadEvents() is in progress.  The most recent event of each download is kept to stop the next download
+ *  once it reaches events that have already been read.
+ */
+void dscKeybusInterface::processPanel_0xAA_EC() {
+  if (!downloadingEvents || eventFinishing || eventKey != 0) return;
+  if (!validCRC()) return;
+
+  dscEvent event;
+  byte timeByte;
+  if (panelData[0] == 0xAA) {
+    timeByte = 2;
+    event.number = panelData[7];
+    event.partition = panelData[3] >> 6;
+    event.statusSet = panelData[5] & 0x03;
+    event.status = panelData[6];
+  }
+  else {
+    timeByte = 3;
+    event.number = panelData[9] + ((panelData[4] >> 6) * 256);
+    event.partition = 0;
+    for (byte partitionBit = 0; partitionBit < 8; partitionBit++) {
+      if (bitRead(panelData[2], partitionBit)) event.partition = partitionBit + 1;
+    }
+    event.statusSet = panelData[7];
+    event.status = panelData[8];
+  }
+
+  decodePanelTime(timeByte, event.year, event.month, event.day, event.hour, event.minute);
+
+  eventRetries = 0;
+
+  // Skips repeated messages for the same event
+  if (eventTotal > 0 && event.number == eventPreviousNumber) return;
+  eventPreviousNumber = event.number;
 
-  if (writePartition != timePartition) {
-    byte previousPartition = writePartition;
-    writePartition = timePartition;
-    write(timeEntry);
-    while(writeKeyPending || writeKeysPending) {
-      loop();
-      #if defined(ESP8266)
-      yield();
-      #endif
+  // Stops at the end of the event buffer or at an event already downloaded
+  bool downloadComplete = (panelData[0] == 0xEC && event.statusSet == 0xFF) || (eventDownloaded && sameEvent(event, newestEvent));
+
+  if (!downloadComplete) {
+    if (eventTotal == 0) downloadedEvent = event;
+
+    byte eventPosition = eventIndex + eventCount;
+    if (eventPosition >= dscEventBufferSize) eventPosition -= dscEventBufferSize;
+    events[eventPosition] = event;
+    eventCount++;
+    eventTotal++;
+
+    // Scrolls to the previous event
+    if (eventTotal >= eventMax) downloadComplete = true;
+    else eventKey = '<';
+  }
+
+  // Exits the event buffer and keeps the most recent event to stop the next download - this is skipped if the
+  // download times out so the remaining events are downloaded next time
+  if (downloadComplete) {
+    eventKey = '#';
+    if (eventTotal > 0) {
+      newestEvent = downloadedEvent;
+      eventDownloaded = true;
     }
-    writePartition = previousPartition;
   }
-  else write(timeEntry);
+}
 
+
+// Stores LCD keypad data as raw bytes and as a string, returns true if the data has changed
+bool dscKeybusInterface::processLCDData(dscLCDData &lcdData, byte dataBytes[]) {
+  bool dataChanged = (lcdData.decimal != decimalInput);
+  for (byte dataByte = 0; dataByte < 4; dataByte++) {
+    if (lcdData.data[dataByte] != dataBytes[dataByte]) dataChanged = true;
+    lcdData.data[dataByte] = dataBytes[dataByte];
+  }
+  if (!dataChanged && lcdData.digits[0] != '\0') return false;
+
+  lcdData.decimal = decimalInput;
+  if (decimalInput) {
+    byte value = lcdData.data[0];
+    lcdData.digits[0] = '0' + (value / 100);
+    lcdData.digits[1] = '0' + ((value / 10) % 10);
+    lcdData.digits[2] = '0' + (value % 10);
+    lcdData.digits[3] = '\0';
+  }
+  else {
+    const char hexDigits[] = "0123456789ABCDEF";
+    for (byte dataByte = 0; dataByte < 4; dataByte++) {
+      lcdData.digits[dataByte * 2] = hexDigits[lcdData.data[dataByte] >> 4];
+      lcdData.digits[(dataByte * 2) + 1] = hexDigits[lcdData.data[dataByte] & 0x0F];
+    }
+    lcdData.digits[8] = '\0';
+  }
   return true;
 }
 
 
+/*
+ *  Processes keypad and module responses to panel queries: 0x11, 0x22, 0x28, 0x33, 0x39, 0x4C, 0xD5, 0xE6.08, 0xE6.0A,
+ *  0xE6.0C, 0xE6.0E - see printModule_0x11() and printModule_Expander() in dscKeybusPrintData.cpp for the slot data.
+ *
+ *  The 0x11 supervision query is answered by all keypads and zone expanders, the remaining queries only by the
+ *  modules with data to send.
+ */
+void dscKeybusInterface::processModuleSlots() {
+  switch (moduleCmd) {
+    case 0x11: {
+      processSlotPresence(keypadSlots, keypadSlotTime, moduleSlots(2, 3, 0xC0, 0, 2, 0), true);
+
+      // Later generation panels report zone expanders 1-7, early generation panels zone expanders 1-3
+      byte respondedSlots;
+      if (moduleByteCount > 7) {
+        respondedSlots = moduleSlots(4, 5, 0xC0, 0x30, 2, 0) << 1;
+        if ((moduleData[7] & 0x03) == 0) respondedSlots |= 0x80;
+      }
+      else respondedSlots = moduleSlots(4, 5, 0xF0, 0xF0, 4, 0) << 1;
+      processSlotPresence(expanderSlots, expanderSlotTime, respondedSlots, true);
+      break;
+    }
+    case 0x4C: processSlotPresence(keypadSlots, keypadSlotTime, ~moduleSlots(2, 5, 0xF0, 0, 4, 0x0F), false); break;
+    case 0xD5: {
+      byte respondedSlots = 0;
+      for (byte moduleByte = 2; moduleByte <= 9; moduleByte++) {
+        if (moduleData[moduleByte] != 0xFF) respondedSlots |= 1 << (moduleByte - 2);
+      }
+      processSlotPresence(keypadSlots, keypadSlotTime, respondedSlots, false);
+      break;
+    }
+    case 0x22:
+    case 0x28:
+    case 0x33:
+    case 0x39:
+    case 0xE6: {
+      byte expander, startByte = 2;
+      switch (moduleCmd) {
+        case 0x22: expander = 0; break;
+        case 0x28: expander = 1; break;
+        case 0x33: expander = 2; break;
+        case 0x39: expander = 3; break;
+        default: expander = (moduleSubCmd - 0x08) / 2 + 4; startByte = 3; break;
+      }
+
+      for (byte moduleByte = startByte; moduleByte < startByte + 4; moduleByte++) {
+        if (moduleData[moduleByte] != 0xFF) {
+          processSlotPresence(expanderSlots, expanderSlotTime, 1 << expander, false);
+          break;
+        }
+      }
+      break;
+    }
+  }
+}
+
+
+// Updates the last response time of the responded slots, supervision responses also clear the slots that did not
+// respond.  With dscSlotTimes set to 1, slotTime[0] is the last response from any slot.
+void dscKeybusInterface::processSlotPresence(byte &slots, unsigned long slotTime[], byte respondedSlots, bool supervision) {
+  unsigned long responseTime = millis();
+  for (byte slot = 0; slot < 8; slot++) {
+    if (bitRead(respondedSlots, slot)) slotTime[slot % dscSlotTimes] = responseTime;
+  }
+
+  if (!supervision) respondedSlots |= slots;
+  if (respondedSlots != slots) {
+    slots = respondedSlots;
+    moduleSlotsChanged = true;
+    if (!pauseStatus) statusChanged = true;
+  }
+}
+
+
+// Returns the first 8 slots matching matchValue as 1 bit per slot, using the same parameters as printModuleSlots()
+byte dscKeybusInterface::moduleSlots(byte startByte, byte endByte, byte startMask, byte endMask, byte bitShift, byte matchValue, bool reverse) {
+  byte matchedSlots = 0;
+  byte slot = 0;
+  for (byte testByte = startByte; testByte <= endByte; testByte++) {
+    byte matchShift = 8 - bitShift;
+    for (byte testMask = startMask; testMask != 0; testMask >>= bitShift) {
+      if ((testByte == endByte && testMask < endMask) || slot > 7) return matchedSlots;
+      if (moduleSlotMatch(testByte, testMask, matchShift, matchValue, reverse)) matchedSlots |= 1 << slot;
+      slot++;
+      matchShift -= bitShift;
+    }
+  }
+  return matchedSlots;
+}
+
+
+// Checks if the slot bits selected by testMask in a module byte match matchValue
+bool dscKeybusInterface::moduleSlotMatch(byte testByte, byte testMask, byte matchShift, byte matchValue, bool reverse) {
+  byte testData = moduleData[testByte];
+
+  // Reverses the bit order
+  if (reverse) {
+    testData = 0;
+    for (byte i = 0; i < 8; i++) testData |= ((moduleData[testByte] >> i) & 1) << (7 - i);
+  }
+
+  return (testData & testMask) >> matchShift == matchValue;
+}
+
+
+// Compares events by content, as event numbers shift as new events are added to the panel event buffer
+bool dscKeybusInterface::sameEvent(dscEvent &event1, dscEvent &event2) {
+  return event1.year == event2.year && event1.month == event2.month && event1.day == event2.day
+         && event1.hour == event2.hour && event1.minute == event2.minute && event1.partition == event2.partition
+         && event1.statusSet == event2.statusSet && event1.status == event2.status;
+}
+
+
 // Processes status commands: 0x05 (Partitions 1-4) and 0x1B (Partitions 5-8)
 void dscKeybusInterface::processPanelStatus() {
 
@@ -184,6 +564,10 @@ void dscKeybusInterface::processPanelStatus() {
       if (!pauseStatus) statusChanged = true;
     }
 
+    // Sets 3 digit decimal input for 0x6E LCD keypad data
+    if (panelData[messageByte] == 0xE7) decimalInput = true;
+    else if (panelData[messageByte] == 0xE4 || panelData[messageByte] == 0xF7) decimalInput = false;
+
     // Fire status
     if (panelData[messageByte] < 0x12) {  // Ignores fire light status in intermittent states
       if (bitRead(panelData[statusByte],6)) fire[partitionIndex] = true;
@@ -236,7 +620,7 @@ void dscKeybusInterface::processPanelStatus() {
           armedAway[partitionIndex] = true;
         }
 
-        writeAccessCode[partitionIndex] = false;
+        resetAccessCodeWrite(partitionIndex);
 
         armed[partitionIndex] = true;
         if (armed[partitionIndex] != previousArmed[partitionIndex] || armedStay[partitionIndex] != previousArmedStay[partitionIndex]) {
@@ -255,7 +639,7 @@ void dscKeybusInterface::processPanelStatus() {
 
       // Exit delay in progress
       case 0x08: {
-        writeAccessCode[partitionIndex] = false;
+        resetAccessCodeWrite(partitionIndex);
 
         processExitDelayStatus(partitionIndex, true);
 
@@ -345,23 +729,14 @@ void dscKeybusInterface::processPanelStatus() {
       // Enter * function code
       case 0x9E:
       case 0xB8: {
-        if (starKeyWait[partitionIndex]) {  // Resets the flag that waits for panel status 0x9E, 0xB8 after '*' is pressed
-          starKeyWait[partitionIndex] = false;
-          starKeyCheck = false;
-          writeKeyPending = false;
-        }
+        processStarKeyWait(partitionIndex);  // Resets the flag that waits for panel status 0x9E, 0xB8 after '*' is pressed
         processReadyStatus(partitionIndex, false);
         break;
       }
 
       // Enter access code
       case 0x9F: {
-        if (writeAccessCode[partitionIndex]) {  // Ensures access codes are only sent when an arm or command output key is sent through this interface
-          writeAccessCode[partitionIndex] = false;
-          accessCodePrompt = true;
-          if (!pauseStatus) statusChanged = true;
-        }
-
+        processAccessCodePrompt(partitionIndex);
         processReadyStatus(partitionIndex, false);
         break;
       }
@@ -461,6 +836,41 @@ void dscKeybusInterface::processPanel_0x3E() {
 }
 
 
+// LCD keypad display data is stored in lcdDisplay
+void dscKeybusInterface::processPanel_0x6E() {
+  if (!validCRC()) return;
+
+  if (processLCDData(lcdDisplay, panelData + 2)) {
+    lcdDisplayChanged = true;
+    if (!pauseStatus) statusChanged = true;
+  }
+}
+
+
+// Keypad beeps for partitions 1-2 are stored in keypadBeeps[0] and keypadBeeps[1]
+void dscKeybusInterface::processPanel_0x64_69() {
+  if (!validCRC()) return;
+  if (panelData[0] == 0x64) processKeypadBeeps(0x01, 2);
+  else processKeypadBeeps(0x02, 2);
+}
+
+
+// Keypad tone for partitions 1-2 is stored in keypadTone[0] and keypadTone[1]
+void dscKeybusInterface::processPanel_0x75_7A() {
+  if (!validCRC()) return;
+  if (panelData[0] == 0x75) processKeypadTone(0x01, 2);
+  else processKeypadTone(0x02, 2);
+}
+
+
+// Keypad buzzer for partitions 1-2 is stored in keypadBuzzer[0] and keypadBuzzer[1]
+void dscKeybusInterface::processPanel_0x7F_82() {
+  if (!validCRC()) return;
+  if (panelData[0] == 0x7F) processKeypadBuzzer(0x01, 2);
+  else processKeypadBuzzer(0x02, 2);
+}
+
+
 /*
  *  PGM outputs 1-14 status is stored in pgmOutputs[]
  *
@@ -472,7 +882,7 @@ void dscKeybusInterface::processPanel_0x87() {
 
   // Resets flag to write access code if needed when writing command output keys
   for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
-    writeAccessCode[partitionIndex] = false;
+    resetAccessCodeWrite(partitionIndex);
   }
 
   pgmOutputs[0] = panelData[3] & 0x03;
@@ -517,6 +927,14 @@ void dscKeybusInterface::processPanel_0xA5() {
 }
 
 
+// Enabled zones 1-32 for partitions 1-2 are stored in enabledZones[0] and enabledZones[1]
+void dscKeybusInterface::processPanel_0xB1() {
+  if (!validCRC()) return;
+  processEnabledZones(0x01, 2, 0);
+  processEnabledZones(0x02, 6, 0);
+}
+
+
 /*
  *  0xE6: Extended status, partitions 1-8
  *  Panels: PC5020, PC1616, PC1832, PC1864
@@ -527,15 +945,67 @@ void dscKeybusInterface::processPanel_0xE6() {
   if (!validCRC()) return;
 
   switch (panelData[2]) {
-    case 0x09: processPanel_0xE6_0x09(); return;  // Zones 33-40 status
-    case 0x0B: processPanel_0xE6_0x0B(); return;  // Zones 41-48 status
-    case 0x0D: processPanel_0xE6_0x0D(); return;  // Zones 49-56 status
-    case 0x0F: processPanel_0xE6_0x0F(); return;  // Zones 57-64 status
-    case 0x1A: processPanel_0xE6_0x1A(); return;  // Panel status
+    case 0x01:
+    case 0x02:
+    case 0x03:
+    case 0x04:
+    case 0x05:
+    case 0x06:
+    case 0x20:
+    case 0x21: processPanel_0xE6_0x01_06_20_21(); return;         // Partitions 1-8 status in programming
+    case 0x09: processPanel_0xE6_0x09(); return;                  // Zones 33-40 status
+    case 0x0B: processPanel_0xE6_0x0B(); return;                  // Zones 41-48 status
+    case 0x0D: processPanel_0xE6_0x0D(); return;                  // Zones 49-56 status
+    case 0x0F: processPanel_0xE6_0x0F(); return;                  // Zones 57-64 status
+    case 0x17:
+    case 0x18: processPanel_0xE6_0x17_18(); return;               // Flash panel lights: status and zones 1-64, partitions 1-8
+    case 0x19: processKeypadBeeps(panelData[3], 4); return;       // Beep, partitions 3-8
+    case 0x1A: processPanel_0xE6_0x1A(); return;                  // Panel status
+    case 0x1D: processKeypadTone(panelData[3], 4); return;        // Tone, partitions 3-8
+    case 0x1F: processKeypadBuzzer(panelData[3], 4); return;      // Buzzer, partitions 3-8
+    case 0x2B: processEnabledZones(panelData[3], 4, 0); return;   // Enabled zones 1-32, partitions 3-8
+    case 0x2C: processEnabledZones(panelData[3], 4, 4); return;   // Enabled zones 33-64, partitions 1-8
+
+    // 0xE6.08, 0A, 0C, 0E zone expander queries are tracked from the module responses and 0xE6.41 zone
+    // lights 65-95 exceed the 64 zones supported by dscZones
   }
 }
 
 
+/*
+ *  Status in programming, partitions 1-8
+ *
+ *  Lights and status messages update lights[] and status[].  The zone lights used by programming menus
+ *  (bypassed zones, zone options) are stored in programZones[] and programZonesChanged[], with byte 9 bit 7
+ *  selecting zones 1-32 or 33-64.
+ */
+void dscKeybusInterface::processPanel_0xE6_0x01_06_20_21() {
+  byte partitionIndex;
+  switch (panelData[2]) {
+    case 0x20: partitionIndex = 0; break;
+    case 0x21: partitionIndex = 1; break;
+    default: partitionIndex = panelData[2] + 1; break;  // 0x01-0x06: Partitions 3-8
+  }
+  if (partitionIndex >= dscPartitions) return;
+
+  lights[partitionIndex] = panelData[3];
+  if (lights[partitionIndex] != previousLights[partitionIndex]) {
+    previousLights[partitionIndex] = lights[partitionIndex];
+    if (!pauseStatus) statusChanged = true;
+  }
+
+  status[partitionIndex] = panelData[4];
+  if (status[partitionIndex] != previousStatus[partitionIndex]) {
+    previousStatus[partitionIndex] = status[partitionIndex];
+    if (!pauseStatus) statusChanged = true;
+  }
+
+  byte startGroup = 0;
+  if (panelData[9] & 0x80) startGroup = 4;
+  processZoneLights(programZones, programZonesChanged, previousProgramZones, programZonesStatusChanged, startGroup, 5);
+}
+
+
 // Zones 33-40 status is stored in openZones[4] and openZonesChanged[4]: Bit 0 = Zone 33 ... Bit 7 = Zone 40
 void dscKeybusInterface::processPanel_0xE6_0x09() {
   if (dscZones > 4) processZoneStatus(4, 3);
@@ -572,6 +1042,45 @@ void dscKeybusInterface::processPanel_0xE6_0x1A() {
     powerChanged = true;
     if (!pauseStatus) statusChanged = true;
   }
+
+  // Loss of system time
+  if (panelData[6] & 0x08) timeTrouble = true;
+  else timeTrouble = false;
+
+  if (timeTrouble != previousTimeTrouble) {
+    previousTimeTrouble = timeTrouble;
+    timeChanged = true;
+    if (!pauseStatus) statusChanged = true;
+  }
+
+  // Fail to communicate
+  if (panelData[6] & 0x40) communicationTrouble = true;
+  else communicationTrouble = false;
+
+  if (communicationTrouble != previousCommunication) {
+    previousCommunication = communicationTrouble;
+    communicationChanged = true;
+    if (!pauseStatus) statusChanged = true;
+  }
+}
+
+
+// Flashing status lights are stored in lightsFlashing[] and flashing zone lights in flashingZones[]
+void dscKeybusInterface::processPanel_0xE6_0x17_18() {
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (!bitRead(panelData[3], partitionIndex)) continue;
+
+    lightsFlashing[partitionIndex] = panelData[4];
+    if (lightsFlashing[partitionIndex] != previousLightsFlashing[partitionIndex]) {
+      previousLightsFlashing[partitionIndex] = lightsFlashing[partitionIndex];
+      lightsFlashingChanged[partitionIndex] = true;
+      if (!pauseStatus) statusChanged = true;
+    }
+  }
+
+  byte startGroup = 0;
+  if (panelData[2] == 0x18) startGroup = 4;
+  processZoneLights(flashingZones, flashingZonesChanged, previousFlashingZones, flashingZonesStatusChanged, startGroup, 5);
 }
 
 
@@ -861,6 +1370,60 @@ void dscKeybusInterface::processPanelStatus5(byte partition, byte panelByte) {
 }
 
 
+// Releases the write slot waiting for the panel to acknowledge the '*' key: status 0x9E/0xB8 or a keypad beep for the
+// partition after the '*' key is written (starKeyWait is set once the write completes).  processWriteTickets() releases
+// the slot after 2s if the panel does not respond.
+void dscKeybusInterface::processStarKeyWait(byte partitionIndex) {
+  if (partitionIndex >= dscPartitions) return;
+
+  // The esp32 decode task records the write state changes for loop() to apply on the sketch core
+  #if defined(ESP32)
+  if (decodeOnly) {
+    bitWrite(starKeyAcks, partitionIndex, 1);
+    return;
+  }
+  #endif
+
+  if (!starKeyWait[partitionIndex]) return;
+
+  byte writeSlot = partitionIndex % dscWriteSlots;
+  writeWaitTime[writeSlot] = millis() - writeEndTime[writeSlot];
+  starKeyWait[partitionIndex] = false;
+  starKeyCheck[writeSlot] = false;
+  writeKeyPending[writeSlot] = false;
+}
+
+
+// Sets accessCodePrompt if an arm or command output key sent through this interface is waiting for the access code
+void dscKeybusInterface::processAccessCodePrompt(byte partitionIndex) {
+  #if defined(ESP32)
+  if (decodeOnly) {
+    bitWrite(accessCodePrompts, partitionIndex, 1);
+    return;
+  }
+  #endif
+
+  if (writeAccessCode[partitionIndex]) {  // Ensures access codes are only sent when an arm or command output key is sent through this interface
+    writeAccessCode[partitionIndex] = false;
+    accessCodePrompt = true;
+    if (!pauseStatus) statusChanged = true;
+  }
+}
+
+
+// Resets the flag to write the access code once the partition no longer needs it
+void dscKeybusInterface::resetAccessCodeWrite(byte partitionIndex) {
+  #if defined(ESP32)
+  if (decodeOnly) {
+    bitWrite(accessCodeResets, partitionIndex, 1);
+    return;
+  }
+  #endif
+
+  writeAccessCode[partitionIndex] = false;
+}
+
+
 void dscKeybusInterface::processReadyStatus(byte partitionIndex, bool status) {
   ready[partitionIndex] = status;
   if (ready[partitionIndex] != previousReady[partitionIndex]) {
@@ -929,18 +1492,97 @@ void dscKeybusInterface::processZoneStatus(byte zonesByte, byte panelByte) {
   }
 }
 
+// Processes 4 bytes of zone lights starting at panelByte into zone groups starting at startGroup
+void dscKeybusInterface::processZoneLights(byte zones[], byte zonesChanged[], byte previousZones[], bool &zonesStatusChanged, byte startGroup, byte panelByte) {
+  for (byte zoneGroup = startGroup; zoneGroup < startGroup + 4 && zoneGroup < dscZones; zoneGroup++) {
+    zones[zoneGroup] = panelData[panelByte + zoneGroup - startGroup];
+    byte changedBits = zones[zoneGroup] ^ previousZones[zoneGroup];
+    if (changedBits != 0) {
+      previousZones[zoneGroup] = zones[zoneGroup];
+      zonesChanged[zoneGroup] |= changedBits;
+      zonesStatusChanged = true;
+      if (!pauseStatus) statusChanged = true;
+    }
+  }
+}
+
+
+// Processes enabled zones for partitions set as a bitmask, zones are stored in enabledZones[partition][zoneGroup]
+void dscKeybusInterface::processEnabledZones(byte partitionMask, byte panelByte, byte startGroup) {
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (!bitRead(partitionMask, partitionIndex)) continue;
+
+    for (byte zoneGroup = startGroup; zoneGroup < startGroup + 4 && zoneGroup < dscZones; zoneGroup++) {
+      enabledZones[partitionIndex][zoneGroup] = panelData[panelByte + zoneGroup - startGroup];
+      if (enabledZones[partitionIndex][zoneGroup] != previousEnabledZones[partitionIndex][zoneGroup]) {
+        previousEnabledZones[partitionIndex][zoneGroup] = enabledZones[partitionIndex][zoneGroup];
+        enabledZonesChanged[partitionIndex] = true;
+        if (!pauseStatus) statusChanged = true;
+      }
+    }
+  }
+}
+
+
+// Keypad beeps are sent as events, each command is flagged as changed
+void dscKeybusInterface::processKeypadBeeps(byte partitionMask, byte panelByte) {
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (!bitRead(partitionMask, partitionIndex)) continue;
+    keypadBeeps[partitionIndex] = panelData[panelByte] / 2;
+    keypadSoundChanged[partitionIndex] = true;
+    processStarKeyWait(partitionIndex);  // The panel beeps the partition keypads once it accepts the '*' key
+    if (!pauseStatus) statusChanged = true;
+  }
+}
+
+
+// Keypad tone: bit 7 = constant tone, bits 4-6 = beeps, bits 0-3 = interval in seconds
+void dscKeybusInterface::processKeypadTone(byte partitionMask, byte panelByte) {
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (!bitRead(partitionMask, partitionIndex)) continue;
+    if (keypadTone[partitionIndex] != panelData[panelByte]) {
+      keypadTone[partitionIndex] = panelData[panelByte];
+      keypadSoundChanged[partitionIndex] = true;
+      if (!pauseStatus) statusChanged = true;
+    }
+  }
+}
+
+
+// Keypad buzzer duration in seconds
+void dscKeybusInterface::processKeypadBuzzer(byte partitionMask, byte panelByte) {
+  for (byte partitionIndex = 0; partitionIndex < dscPartitions; partitionIndex++) {
+    if (!bitRead(partitionMask, partitionIndex)) continue;
+    if (keypadBuzzer[partitionIndex] != panelData[panelByte]) {
+      keypadBuzzer[partitionIndex] = panelData[panelByte];
+      keypadSoundChanged[partitionIndex] = true;
+      if (!pauseStatus) statusChanged = true;
+    }
+  }
+}
+
+
+// Decodes the panel date and time starting at panelByte for commands 0xA5, 0xAA, 0xEB, 0xEC, with a 2 digit year
+void dscKeybusInterface::decodePanelTime(byte panelByte, byte &timeYear, byte &timeMonth, byte &timeDay, byte &timeHour, byte &timeMinute) {
+  timeYear = ((panelData[panelByte] >> 4) * 10) + (panelData[panelByte] & 0x0F);
+  timeMonth = (panelData[panelByte + 1] >> 2) & 0x0F;
+  timeDay = ((panelData[panelByte + 1] & 0x03) << 3) | (panelData[panelByte + 2] >> 5);
+  timeHour = panelData[panelByte + 2] & 0x1F;
+  timeMinute = panelData[panelByte + 3] >> 2;
+}
+
+
 void dscKeybusInterface::processTime(byte panelByte) {
-  byte dscYear3 = panelData[panelByte] >> 4;
-  byte dscYear4 = panelData[panelByte] & 0x0F;
-  year = (dscYear3 * 10) + dscYear4;
-  if (dscYear3 >= 7) year += 1900;
+  byte dscYear;
+  decodePanelTime(panelByte, dscYear, month, day, hour, minute);
+  year = dscYear;
+  if (dscYear >= 70) year += 1900;
   else year += 2000;
-  month = panelData[panelByte + 1] << 2; month >>=4;
-  byte dscDay1 = panelData[panelByte + 1] << 6; dscDay1 >>= 3;
-  byte dscDay2 = panelData[panelByte + 2] >> 5;
-  day = dscDay1 | dscDay2;
-  hour = panelData[panelByte + 2] & 0x1F;
-  minute = panelData[panelByte + 3] >> 2;
+
+  // Stores the time for timeSyncRequired()
+  timeMinutes = dateMinutes(year, month, day, hour, minute);
+  timeReceivedTime = millis();
+  timeReceived = true;
 }
 
 
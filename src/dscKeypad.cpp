@@ -33,7 +33,39 @@ dscKeypadInterface::dscKeypadInterface(byte setClockPin, byte setReadPin, byte s
   dscWritePin = setWritePin;
   commandReady = true;
   keyData = 0xFF;
+  previousKey = 0xFF;
+  keyRepeatInterval = 500;
   clockInterval = 57800;  // Sets AVR timer 1 to trigger an overflow interrupt every ~500us to generate a 1kHz clock signal
+
+  panelCommand = panelCommand16;
+
+  // Sets the panel command frames - checksums are kept up to date by setCommandByte() as each byte is set
+  const byte zonesCommandBytes[] = {0x27, 0x2D, 0x34, 0x3E};
+  for (byte zoneGroup = 0; zoneGroup < dscZones; zoneGroup++) {
+    if (zoneGroup < 4) setCommandByte(zonesCommands[zoneGroup], 7, 0, zonesCommandBytes[zoneGroup]);
+    else {
+      setCommandByte(zonesCommands[zoneGroup], 4, 0, 0xE6);
+      setCommandByte(zonesCommands[zoneGroup], 4, 1, 0x09 + ((zoneGroup - 4) * 2));
+    }
+  }
+
+  setCommandByte(blinkCommands[0], 7, 0, 0x5D);
+  if (dscZones > 4) {
+    setCommandByte(blinkCommands[1], 9, 0, 0xE6);
+    setCommandByte(blinkCommands[1], 9, 1, 0x18);
+    setCommandByte(blinkCommands[1], 9, 2, 0x01);  // Partition 1
+  }
+
+  // Sets partition 1 as ready and partitions 2-8 as disabled
+  statusCommands[0][0] = 0x05;
+  if (dscPartitions > 4) statusCommands[1][0] = 0x1B;
+  partitionLights[0] = 0x81;
+  partitionStatus[0] = 0x01;
+  for (byte partition = 1; partition < dscPartitions; partition++) {
+    partitionLights[partition] = 0x10;
+    partitionStatus[partition] = 0xC7;
+  }
+  for (byte partition = 0; partition < dscPartitions; partition++) setPartitionCommands(partition);
 }
 
 
@@ -69,7 +101,7 @@ void dscKeypadInterface::begin(Stream &_stream) {
   timerAlarmEnable(timer1);
   #endif
 
-  intervalStart = millis();
+  commandEndTime = micros();
 
   unsigned long keybusTime = millis();
   while (millis() - keybusTime < 4000) {  // Waits for the keypad to be powered on
@@ -83,8 +115,14 @@ void dscKeypadInterface::begin(Stream &_stream) {
 
 bool dscKeypadInterface::loop() {
 
-  // Sets up the next panel command once the previous command is complete
-  if (commandReady && millis() - intervalStart >= commandInterval) {
+  // Sets up the next panel command once the previous command is complete - queued commands are sent back to back,
+  // and status commands at commandInterval while idle.  The interval is measured from the end of the previous command
+  // and kept at 2ms or more, above the 1ms clock reset used by the Keybus interface to separate commands.
+  byte interval = commandInterval;
+  if (pendingCommands & ~(1 << commandStatus)) interval = queuedCommandInterval;
+  if (interval < 2) interval = 2;
+
+  if (commandReady && micros() - commandEndTime >= interval * 1000UL) {
     commandReady = false;
 
     // Sets the startup command sequence
@@ -92,132 +130,137 @@ bool dscKeypadInterface::loop() {
       static byte startupCommand = 0x16;
       switch (startupCommand) {
         case 0x16: {
-          for (byte i = 0; i < 5; i++) panelCommand[i] = panelCommand16[i];
-          panelCommandByteTotal = 5;
+          setPanelCommand(panelCommand16, 5);
           startupCommand = 0x5D;
           break;
         }
         case 0x5D: {
           delay(200);
-          for (byte i = 0; i < 7; i++) panelCommand[i] = panelCommand5D[i];
-          panelCommandByteTotal = 7;
+          setBlinkCommand(0);
           startupCommand = 0x4C;
           break;
         }
         case 0x4C: {
-          for (byte i = 0; i < 12; i++) panelCommand[i] = panelCommand4C[i];
-          panelCommandByteTotal = 12;
+          setPanelCommand(panelCommand4C, 12);
           startupCommand = 0xB1;
           break;
         }
         case 0xB1: {
-          for (byte i = 0; i < 10; i++) panelCommand[i] = panelCommandB1[i];
-          panelCommandByteTotal = 10;
+          setPanelCommand(panelCommandB1, 10);
           startupCommand = 0xA5;
           break;
         }
         case 0xA5: {
-          for (byte i = 0; i < 8; i++) panelCommand[i] = panelCommandA5[i];
-          panelCommandByteTotal = 8;
+          setPanelCommand(panelCommandA5, 8);
           startupCommand = 0x05;
           break;
         }
         case 0x05: {
-          for (byte i = 0; i < 5; i++) panelCommand[i] = panelCommand05[i];
-          panelCommandByteTotal = 5;
+          setStatusCommand(0x05);
           startupCommand = 0xD5;
           break;
         }
         case 0xD5: {
-          for (byte i = 0; i < 9; i++) panelCommand[i] = panelCommandD5[i];
-          panelCommandByteTotal = 9;
+          setPanelCommand(panelCommandD5, 9);
           startupCommand = 0x27;
           break;
         }
         case 0x27: {
-          for (byte i = 0; i < 7; i++) panelCommand[i] = panelCommand27[i];
-          panelCommandByteTotal = 7;
+          setZonesCommand(0);
           startupCycle = false;
           break;
         }
       }
     }
 
-    // Sets the next panel command to 0x1C alarm key verification if an alarm key is pressed
-    else if (alarmKeyDetected) {
-      alarmKeyDetected = false;
-      alarmKeyResponsePending = true;
-      panelCommand[0] = 0x1C;
-      panelCommandByteTotal = 1;
-    }
-
-    // Sets the next panel command
-    else if (!alarmKeyResponsePending) {
+    // Sets the next panel command from the queued commands
+    else {
+      setLights();
 
-      // Sets lights
-      if (panelLights != previousLights) {
-        previousLights = panelLights;
-        panelCommand05[1] = panelLights;
-        panelCommand27[1] = panelLights;
+      // Queues 0x1C alarm key verification if an alarm key is pressed
+      if (alarmKeyDetected) {
+        alarmKeyDetected = false;
+        queueCommand(commandAlarm, 0);
       }
 
-      // Sets next panel command to 0xD5 keypad zone query on keypad zone notification
+      // Queues 0xD5 keypad zone query on keypad zone notification
       if (panelCommand[0] == 0x05 && !bitRead(moduleData[5], 2)) {
-        for (byte i = 0; i < 9; i++) panelCommand[i] = panelCommandD5[i];
-        panelCommandByteTotal = 9;
+        moduleData[5] |= 0x04;  // Clears the notification so the query is only queued once
+        queueCommand(commandZoneQuery, 10);
       }
 
-      // Sets next panel command to 0x27 zones 1-8 status if a zone changed
-      else if (panelZones != previousZones) {
-        previousZones = panelZones;
-        panelCommand27[5] = panelZones;
+      switch (nextCommand()) {
 
-        int dataSum = 0;
-        for (byte panelByte = 0; panelByte < 6; panelByte++) dataSum += panelCommand27[panelByte];
-        panelCommand27[6] = dataSum % 256;
+        // Sets the panel command to 0x1C alarm key verification
+        case commandAlarm: {
+          setPanelCommand(panelCommand1C, 1);
+          break;
+        }
 
-        for (byte i = 0; i < 7; i++) panelCommand[i] = panelCommand27[i];
-        panelCommandByteTotal = 7;
-      }
+        // Sets the panel command to 0xD5 keypad zone query
+        case commandZoneQuery: {
+          setPanelCommand(panelCommandD5, 9);
+          break;
+        }
 
-      else if (panelBlink != previousBlink || panelZonesBlink != previousZonesBlink) {
-        previousBlink = panelBlink;
-        previousZonesBlink = panelZonesBlink;
-        panelCommand5D[1] = panelBlink;
-        panelCommand5D[2] = panelZonesBlink;
+        // Sets the panel command for the next changed zone group
+        case commandZones: {
+          byte zoneGroup = 0;
+          while (!bitRead(pendingZones, zoneGroup)) zoneGroup++;
+          bitClear(pendingZones, zoneGroup);
+          setZonesCommand(zoneGroup);
+          if (pendingZones) queueCommand(commandZones, 20);
+          break;
+        }
 
-        int dataSum = 0;
-        for (byte panelByte = 0; panelByte < 6; panelByte++) dataSum += panelCommand5D[panelByte];
-        panelCommand5D[6] = dataSum % 256;
+        // Sets the panel command for the next changed flashing lights
+        case commandBlink: {
+          byte blinkGroup = 0;
+          while (!bitRead(pendingBlink, blinkGroup)) blinkGroup++;
+          bitClear(pendingBlink, blinkGroup);
+          setBlinkCommand(blinkGroup);
+          if (pendingBlink) queueCommand(commandBlink, 20);
+          break;
+        }
 
-        for (byte i = 0; i < 7; i++) panelCommand[i] = panelCommand5D[i];
-        panelCommandByteTotal = 7;
-      }
+        // Sets the panel command to 0x64 beep set by beep()
+        case commandBeep: {
+          setCommandByte(panelCommand64, 3, 1, beepData);
+          setPanelCommand(panelCommand64, 3);
+          break;
+        }
 
-      // Sets next panel command to 0x64 beep if beep() is called
-      else if (setBeep) {
-        setBeep = false;
-        for (byte i = 0; i < 3; i++) panelCommand[i] = panelCommand64[i];
-        panelCommandByteTotal = 3;
-      }
+        // Sets the panel command to 0x75 tone set by tone()
+        case commandTone: {
+          setCommandByte(panelCommand75, 3, 1, toneData);
+          setPanelCommand(panelCommand75, 3);
+          break;
+        }
 
-      else if (setTone) {
-        setTone = false;
-        for (byte i = 0; i < 3; i++) panelCommand[i] = panelCommand75[i];
-        panelCommandByteTotal = 3;
-      }
+        // Sets the panel command to 0x7F buzzer set by buzzer()
+        case commandBuzzer: {
+          setCommandByte(panelCommand7F, 3, 1, buzzerData);
+          setPanelCommand(panelCommand7F, 3);
+          break;
+        }
 
-      else if (setBuzzer) {
-        setBuzzer = false;
-        for (byte i = 0; i < 3; i++) panelCommand[i] = panelCommand7F[i];
-        panelCommandByteTotal = 3;
+        // Sets the panel command to a changed status command, or alternates 0x05 and 0x1B while idle so keypads on
+        // partitions 5-8 are polled for keys
+        default: {
+          if (bitRead(pendingStatus, 0)) statusCommand = 0x05;
+          else if (bitRead(pendingStatus, 1) || (dscPartitions > 4 && statusCommand == 0x05)) statusCommand = 0x1B;
+          else statusCommand = 0x05;
+
+          if (statusCommand == 0x05) bitClear(pendingStatus, 0);
+          else bitClear(pendingStatus, 1);
+          setStatusCommand(statusCommand);
+          if (pendingStatus) queueCommand(commandStatus, 20);
+          break;
+        }
       }
 
-      // Sets next panel command to 0x05 status command
-      else {
-        for (byte i = 0; i < 5; i++) panelCommand[i] = panelCommand05[i];
-        panelCommandByteTotal = 5;
-      }
+      // Keeps the status commands polling for keys while commands are queued
+      if (panelCommand[0] != 0x05 && panelCommand[0] != 0x1B) queueCommand(commandStatus, 50);
     }
     clockCycleCount = 0;
     clockCycleTotal = (panelCommandByteTotal * 16) + 4;
@@ -230,48 +273,27 @@ bool dscKeypadInterface::loop() {
     timerStart(timer1);
     #endif
   }
-  else if (!commandReady) intervalStart = millis();
-
-  // Sets panel lights
-  panelLight(lightReady, 0);
-  panelLight(lightArmed, 1);
-  panelLight(lightMemory, 2);
-  panelLight(lightBypass, 3);
-  panelLight(lightTrouble, 4);
-  panelLight(lightProgram, 5);
-  panelLight(lightFire, 6);
-  panelLight(lightBacklight, 7);
-
-  // Sets zone lights
-  zoneLight(lightZone1, 0);
-  zoneLight(lightZone2, 1);
-  zoneLight(lightZone3, 2);
-  zoneLight(lightZone4, 3);
-  zoneLight(lightZone5, 4);
-  zoneLight(lightZone6, 5);
-  zoneLight(lightZone7, 6);
-  zoneLight(lightZone8, 7);
 
   // Skips key processing if the key buffer is empty
   if (keyBufferLength == 0) return false;
 
-  // Copies data from the buffer to keyData
-  static byte keyBufferIndex = 1;
-  byte dataIndex = keyBufferIndex - 1;
+  // Copies the oldest key from the buffer to keyData
+  byte dataIndex = keyBufferIndex;
   keyData = keyBuffer[dataIndex];
-  keyBufferIndex++;
+  keyPartition = keyBufferPartition[dataIndex];
+  keyTime = keyBufferTime[dataIndex];
+  keyRepeat = keyBufferRepeat[dataIndex];
 
-  // Resets counters when the buffer is cleared
+  // Removes the key from the buffer
   #if defined(ESP32)
   portENTER_CRITICAL(&timer1Mux);
   #else
   noInterrupts();
   #endif
 
-  if (keyBufferIndex > keyBufferLength) {
-    keyBufferIndex = 1;
-    keyBufferLength = 0;
-  }
+  keyBufferIndex++;
+  if (keyBufferIndex >= dscBufferSize) keyBufferIndex = 0;
+  keyBufferLength--;
 
   #if defined(ESP32)
   portEXIT_CRITICAL(&timer1Mux);
@@ -315,85 +337,255 @@ bool dscKeypadInterface::loop() {
 }
 
 
-void dscKeypadInterface::panelLight(Light lightPanel, byte zoneBit) {
-  if (lightPanel == on) {
-    bitWrite(panelLights, zoneBit, 1);
-    bitWrite(panelBlink, zoneBit, 0);
+// Sets the panel and zone lights and queues the commands for changed lights and partition status
+void dscKeypadInterface::setLights() {
+  byte lights = partitionLights[0];
+  byte lightsBlink = blinkCommands[0][1];
+  setLight(lightReady, lights, lightsBlink, 0);
+  setLight(lightArmed, lights, lightsBlink, 1);
+  setLight(lightMemory, lights, lightsBlink, 2);
+  setLight(lightBypass, lights, lightsBlink, 3);
+  setLight(lightTrouble, lights, lightsBlink, 4);
+  setLight(lightProgram, lights, lightsBlink, 5);
+  setLight(lightFire, lights, lightsBlink, 6);
+  setLight(lightBacklight, lights, lightsBlink, 7);
+  partitionLights[0] = lights;
+
+  for (byte partition = 0; partition < dscPartitions; partition++) {
+    byte partitionByte = ((partition % 4) * 2) + 1;
+    if (partitionLights[partition] != statusCommands[partition / 4][partitionByte] || partitionStatus[partition] != statusCommands[partition / 4][partitionByte + 1]) {
+      setPartitionCommands(partition);
+      bitSet(pendingStatus, partition / 4);  // 0x05: partitions 1-4, 0x1B: partitions 5-8
+      queueCommand(commandStatus, 20);
+    }
   }
-  else if (lightPanel == blink) bitWrite(panelBlink, zoneBit, 1);
-  else {
-    bitWrite(panelLights, zoneBit, 0);
-    bitWrite(panelBlink, zoneBit, 0);
+
+  for (byte blinkGroup = 0; blinkGroup < (dscZones + 3) / 4; blinkGroup++) {
+    byte blinkByteTotal = 7, blinkByte = 1;
+    if (blinkGroup > 0) {
+      blinkByteTotal = 9;
+      blinkByte = 3;
+    }
+
+    if (lightsBlink != blinkCommands[blinkGroup][blinkByte]) {
+      setCommandByte(blinkCommands[blinkGroup], blinkByteTotal, blinkByte, lightsBlink);
+      bitSet(pendingBlink, blinkGroup);
+      queueCommand(commandBlink, 20);
+    }
+  }
+
+  for (byte zoneGroup = 0; zoneGroup < dscZones; zoneGroup++) {
+    byte zonesByteTotal = 7, zonesByte = 5;
+    if (zoneGroup >= 4) {
+      zonesByteTotal = 4;
+      zonesByte = 2;
+    }
+
+    byte blinkGroup = zoneGroup / 4;
+    byte blinkByteTotal = 7, blinkByte = 2 + (zoneGroup % 4);
+    if (blinkGroup > 0) {
+      blinkByteTotal = 9;
+      blinkByte += 2;
+    }
+
+    byte zones = zonesCommands[zoneGroup][zonesByte];
+    byte zonesBlink = blinkCommands[blinkGroup][blinkByte];
+    for (byte zoneBit = 0; zoneBit < 8; zoneBit++) {
+      setLight(lightZones[(zoneGroup * 8) + zoneBit], zones, zonesBlink, zoneBit);
+    }
+
+    if (zones != zonesCommands[zoneGroup][zonesByte]) {
+      setCommandByte(zonesCommands[zoneGroup], zonesByteTotal, zonesByte, zones);
+      bitSet(pendingZones, zoneGroup);
+      queueCommand(commandZones, 20);
+    }
+
+    if (zonesBlink != blinkCommands[blinkGroup][blinkByte]) {
+      setCommandByte(blinkCommands[blinkGroup], blinkByteTotal, blinkByte, zonesBlink);
+      bitSet(pendingBlink, blinkGroup);  // 0x5D: zones 1-32, 0xE6.18: zones 33-64
+      queueCommand(commandBlink, 20);
+    }
+  }
+}
+
+
+// Queues a panel command to be sent within deadline milliseconds - a command already queued keeps the earlier
+// deadline and is sent once with the current data
+void dscKeypadInterface::queueCommand(byte command, byte deadline) {
+  unsigned long queuedDeadline = millis() + deadline;
+  if (bitRead(pendingCommands, command) && (long)(queuedDeadline - commandDeadline[command]) >= 0) return;
+  bitSet(pendingCommands, command);
+  commandDeadline[command] = queuedDeadline;
+}
+
+
+// Removes the next panel command from the queue: the command with the earliest passed deadline, otherwise the
+// queued command with the highest priority.  Returns commandStatus if no commands are queued.
+byte dscKeypadInterface::nextCommand() {
+  unsigned long currentTime = millis();
+  byte command = commandStatus;
+  long commandLate = 0;
+  bool commandFound = false;
+
+  for (byte queuedCommand = 0; queuedCommand < commandCount; queuedCommand++) {
+    if (!bitRead(pendingCommands, queuedCommand)) continue;
+
+    long queuedLate = (long)(currentTime - commandDeadline[queuedCommand]);
+    if (!commandFound || (queuedLate >= 0 && queuedLate > commandLate)) {
+      command = queuedCommand;
+      commandLate = queuedLate;
+      commandFound = true;
+    }
   }
+
+  bitClear(pendingCommands, command);
+  return command;
 }
 
 
-void dscKeypadInterface::zoneLight(Light lightZone, byte zoneBit) {
-  if (lightZone == on ) {
-    bitWrite(panelZones, zoneBit, 1);
-    bitWrite(panelZonesBlink, zoneBit, 0);
+void dscKeypadInterface::setLight(Light light, byte &lights, byte &lightsBlink, byte lightBit) {
+  if (light == on) {
+    bitWrite(lights, lightBit, 1);
+    bitWrite(lightsBlink, lightBit, 0);
   }
-  else if (lightZone == blink) bitWrite(panelZonesBlink, zoneBit, 1);
+  else if (light == blink) bitWrite(lightsBlink, lightBit, 1);
   else {
-    bitWrite(panelZones, zoneBit, 0);
-    bitWrite(panelZonesBlink, zoneBit, 0);
+    bitWrite(lights, lightBit, 0);
+    bitWrite(lightsBlink, lightBit, 0);
+  }
+}
+
+
+// Sets the partition lights and status in its status command, and for partitions 1-2 in the zones 1-32 commands
+void dscKeypadInterface::setPartitionCommands(byte partition) {
+  byte partitionByte = ((partition % 4) * 2) + 1;
+  statusCommands[partition / 4][partitionByte] = partitionLights[partition];
+  statusCommands[partition / 4][partitionByte + 1] = partitionStatus[partition];
+
+  if (partition < 2) {
+    for (byte zoneGroup = 0; zoneGroup < 4 && zoneGroup < dscZones; zoneGroup++) {
+      setCommandByte(zonesCommands[zoneGroup], 7, partitionByte, partitionLights[partition]);
+      setCommandByte(zonesCommands[zoneGroup], 7, partitionByte + 1, partitionStatus[partition]);
+    }
   }
 }
 
 
+// Sets the panel command to 0x05 status for partitions 1-4 or 0x1B status for partitions 5-8
+void dscKeypadInterface::setStatusCommand(byte command) {
+  byte statusGroup = 0;
+  if (command == 0x1B) statusGroup = 1;
+
+  byte partitionTotal = dscPartitions - (statusGroup * 4);
+  if (partitionTotal > 4) partitionTotal = 4;
+  setPanelCommand(statusCommands[statusGroup], (partitionTotal * 2) + 1);
+}
+
+
+// Sets the panel command for a group of 8 zones: 0x27, 0x2D, 0x34, 0x3E with partitions 1-2 status for zones 1-32,
+// and 0xE6.09, 0xE6.0B, 0xE6.0D, 0xE6.0F for zones 33-64
+void dscKeypadInterface::setZonesCommand(byte zoneGroup) {
+  if (zoneGroup < 4) setPanelCommand(zonesCommands[zoneGroup], 7);
+  else setPanelCommand(zonesCommands[zoneGroup], 4);
+}
+
+
+// Sets the panel command for flashing lights: 0x5D for partition 1 status lights and zones 1-32, and 0xE6.18 for
+// partition 1 status lights and zones 33-64
+void dscKeypadInterface::setBlinkCommand(byte blinkGroup) {
+  if (blinkGroup == 0) setPanelCommand(blinkCommands[0], 7);
+  else setPanelCommand(blinkCommands[1], 9);
+}
+
+
+// Sets a panel command byte and adjusts the checksum in the last byte by the difference, so frames never need to be
+// summed again
+void dscKeypadInterface::setCommandByte(byte command[], byte commandByteTotal, byte commandByte, byte commandData) {
+  command[commandByteTotal - 1] += commandData - command[commandByte];
+  command[commandByte] = commandData;
+}
+
+
+// Sets dscClockInterrupt() to send a panel command frame in place - frames are only changed while the clock is
+// stopped between commands, so the frame being sent is never written
+void dscKeypadInterface::setPanelCommand(byte command[], byte commandByteTotal) {
+  panelCommand = command;
+  panelCommandByteTotal = commandByteTotal;
+}
+
 
 void dscKeypadInterface::beep(byte beeps) {
   if (!beeps) {
-    setBeep = false;
+    bitClear(pendingCommands, commandBeep);
     return;
   }
 
   if (beeps >= 128) beeps = 255;
   else beeps *= 2;
-  panelCommand64[1] = beeps;
-
-  int dataSum = 0;
-  for (byte panelByte = 0; panelByte < 2; panelByte++) dataSum += panelCommand64[panelByte];
-  panelCommand64[2] = dataSum % 256;
+  beepData = beeps;
 
-  setBeep = true;
+  queueCommand(commandBeep, 50);
 }
 
 
 void dscKeypadInterface::tone(byte beep, bool tone, byte interval) {
-  panelCommand75[1] = 0;
+  toneData = 0;
 
-  if (tone >= 1) panelCommand75[1] |= 0x80;
+  if (tone >= 1) toneData |= 0x80;
 
   if (beep > 7) beep = 7;
   if (beep >= 1) {
-    panelCommand75[1] |= beep << 4;
+    toneData |= beep << 4;
   }
 
   if (interval > 15) interval = 15;
-  panelCommand75[1] |= interval;
+  toneData |= interval;
 
-  int dataSum = 0;
-  for (byte panelByte = 0; panelByte < 2; panelByte++) dataSum += panelCommand75[panelByte];
-  panelCommand75[2] = dataSum % 256;
-
-  setTone = true;
+  queueCommand(commandTone, 50);
 }
 
 
 void dscKeypadInterface::buzzer(byte seconds) {
   if (!seconds) {
-    setBuzzer = false;
+    bitClear(pendingCommands, commandBuzzer);
     return;
   }
 
-  panelCommand7F[1] = seconds;
+  buzzerData = seconds;
+
+  queueCommand(commandBuzzer, 50);
+}
 
-  int dataSum = 0;
-  for (byte panelByte = 0; panelByte < 2; panelByte++) dataSum += panelCommand7F[panelByte];
-  panelCommand7F[2] = dataSum % 256;
 
-  setBuzzer = true;
+// Stores a key in the key buffer with the time it was pressed and the number of times it was repeated
+#if defined(__AVR__)
+void dscKeypadInterface::bufferKey(byte keyValue, byte partition) {
+#elif defined(ESP8266)
+void ICACHE_RAM_ATTR dscKeypadInterface::bufferKey(byte keyValue, byte partition) {
+#elif defined(ESP32)
+void IRAM_ATTR dscKeypadInterface::bufferKey(byte keyValue, byte partition) {
+#endif
+  unsigned long keyPressTime = millis();
+  if (keyValue == previousKey && partition == previousKeyPartition && keyPressTime - previousKeyTime < keyRepeatInterval) {
+    if (keyRepeatCount < 255) keyRepeatCount++;
+  }
+  else keyRepeatCount = 0;
+  previousKey = keyValue;
+  previousKeyPartition = partition;
+  previousKeyTime = keyPressTime;
+
+  if (keyBufferLength == dscBufferSize) {
+    bufferOverflow = true;
+    return;
+  }
+
+  byte keyIndex = keyBufferIndex + keyBufferLength;
+  if (keyIndex >= dscBufferSize) keyIndex -= dscBufferSize;
+  keyBuffer[keyIndex] = keyValue;
+  keyBufferPartition[keyIndex] = partition;
+  keyBufferTime[keyIndex] = keyPressTime;
+  keyBufferRepeat[keyIndex] = keyRepeatCount;
+  keyBufferLength++;
 }
 
 
@@ -458,19 +650,14 @@ void IRAM_ATTR dscKeypadInterface::dscClockInterrupt() {
 
         // Checks for an alarm key sent during 0x1C alarm key verification command to save in the key buffer
         if (panelCommand[0] == 0x1C) {
-          alarmKeyResponsePending = false;
-
           if (isrModuleData[0] != 0xFF) {
-            if (keyBufferLength >= dscBufferSize) bufferOverflow = true;
-            else {
-
-              // Converts the DSC alarm key value to handle a conflict with the door chime key (0xBB)
-              switch (isrModuleData[0]) {
-                case 0xBB: keyBuffer[keyBufferLength] = 0x0B; keyBufferLength++; break;  // Fire alarm
-                case 0xDD: keyBuffer[keyBufferLength] = 0x0D; keyBufferLength++; break;  // Aux alarm
-                case 0xEE: keyBuffer[keyBufferLength] = 0x0E; keyBufferLength++; break;  // Panic alarm
-                default: break;
-              }
+
+            // Converts the DSC alarm key value to handle a conflict with the door chime key (0xBB)
+            switch (isrModuleData[0]) {
+              case 0xBB: bufferKey(0x0B, 0); break;  // Fire alarm
+              case 0xDD: bufferKey(0x0D, 0); break;  // Aux alarm
+              case 0xEE: bufferKey(0x0E, 0); break;  // Panic alarm
+              default: break;
             }
           }
         }
@@ -513,12 +700,17 @@ void IRAM_ATTR dscKeypadInterface::dscClockInterrupt() {
         alarmKeyDetected = true;
       }
 
-      // Checks for a partition 1 key to save in the key buffer
-      if (isrModuleData[2] != 0xFF && panelCommand[0] == 0x05) {
-        if (keyBufferLength >= dscBufferSize) bufferOverflow = true;
-        else {
-          keyBuffer[keyBufferLength] = isrModuleData[2];
-          keyBufferLength++;
+      // Checks for partition keys to save in the key buffer: bytes 2-3 for partitions 1-2 (0x05) or 5-6 (0x1B), and
+      // bytes 8-9 for partitions 3-4 or 7-8
+      if (panelCommand[0] == 0x05 || panelCommand[0] == 0x1B) {
+        for (byte keyByte = 2; keyByte <= 9 && keyByte <= panelCommandByteTotal; keyByte++) {
+          if (keyByte == 4) keyByte = 8;
+          if (isrModuleData[keyByte] == 0xFF) continue;
+
+          byte partition = keyByte - 1;
+          if (keyByte >= 8) partition = keyByte - 5;
+          if (panelCommand[0] == 0x1B) partition += 4;
+          bufferKey(isrModuleData[keyByte], partition);
         }
       }
     }
@@ -531,6 +723,7 @@ void IRAM_ATTR dscKeypadInterface::dscClockInterrupt() {
     panelCommandByteCount = 0;
     isrPanelBitTotal = 0;
     isrPanelBitCount = 0;
+    commandEndTime = micros();
     commandReady = true;
 
     #if defined(__AVR__)
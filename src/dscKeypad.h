@@ -24,8 +24,12 @@
 
 #if defined(__AVR__)
 const byte dscBufferSize = 10;  // Number of keys to buffer if the sketch is busy
+const byte dscPartitions = 4;   // Maximum number of partitions
+const byte dscZones = 4;        // Maximum number of zone groups, 8 zones per group
 #elif defined(ESP8266) || defined (ESP32)
 const byte dscBufferSize = 50;
+const byte dscPartitions = 8;
+const byte dscZones = 8;
 #endif
 const byte dscReadSize = 16;    // Maximum bytes of a Keybus command
 
@@ -43,19 +47,28 @@ class dscKeypadInterface {
     void tone(byte beep = 0, bool tone = false, byte interval = 0);  // Keypad tone pattern, 1-7 beeps at 1-15s interval, with optional constant tone
     void buzzer(byte seconds = 0);                                   // Keypad buzzer, 1-255 seconds
 
-    // Keypad key
-    byte key, keyAvailable;
+    // Keypad key and the partition of the keypad, 0 for fire/auxiliary/panic alarm keys
+    byte key, keyAvailable, keyPartition;
 
-    // Keypad lights
+    // Time in milliseconds when the key was pressed, and the number of times in a row the same key was pressed on the
+    // same partition within keyRepeatInterval
+    unsigned long keyTime;
+    byte keyRepeat;
+
+    // Keypad lights: status lights for partition 1, and zone lights for zones 1-64 (lightZones[0]: zone 1).  Zones 1-8
+    // can also be set by name as in dscClassicKeypadInterface.
     Light lightReady = on, lightArmed, lightMemory, lightBypass, lightTrouble, lightProgram, lightFire, lightBacklight = on;
-    Light lightZone1, lightZone2, lightZone3, lightZone4, lightZone5, lightZone6, lightZone7, lightZone8;
+    Light lightZones[dscZones * 8];
+    Light &lightZone1 = lightZones[0], &lightZone2 = lightZones[1], &lightZone3 = lightZones[2], &lightZone4 = lightZones[3];
+    Light &lightZone5 = lightZones[4], &lightZone6 = lightZones[5], &lightZone7 = lightZones[6], &lightZone8 = lightZones[7];
+
+    // Partition status lights and status messages sent in the 0x05 and 0x1B status commands, see printPanelLights() and
+    // printPanelMessages() in dscKeybusPrintData.cpp.  partitionLights[0] is set from the partition 1 status lights.
+    byte partitionLights[dscPartitions], partitionStatus[dscPartitions];
 
     // Panel Keybus commands
-    byte panelCommand05[5]  = {0x05, 0x81, 0x01, 0x10, 0xC7};                                            // Partition 1: Ready Backlight - Partition ready | Partition 2: disabled
     byte panelCommand16[5]  = {0x16, 0x0E, 0x23, 0xF1, 0x38};                                            // Panel version: v2.3 | Zone wiring: NC | Code length: 4 digits | *8 programming: no
-    byte panelCommand27[7]  = {0x27, 0x81, 0x01, 0x10, 0xC7, 0x00, 0x80};                                // Partition 1: Ready Backlight - Partition ready | Partition 2: disabled | Zones 1-8 open: none
     byte panelCommand4C[12] = {0x4C, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA};  // Module tamper query
-    byte panelCommand5D[7]  = {0x5D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5D};                                // Partition 1 | Status lights flashing: none | Zones 1-32 flashing: none
     byte panelCommand64[3]  = {0x64, 0x0, 0x64};                                                         // Beep pattern, 1-128 beeps
     byte panelCommand75[3]  = {0x75, 0x0, 0x75};                                                         // Tone pattern, beeps at interval with optional constant tone
     byte panelCommand7F[3]  = {0x7F, 0x0, 0x7F};                                                         // Buzzer, 1-255 seconds
@@ -73,23 +86,44 @@ class dscKeypadInterface {
     // Key data buffer overflow, true if dscBufferSize needs to be increased
     static volatile bool bufferOverflow;
 
+    // Sets the milliseconds between presses of the same key to count as a repeat
+    static unsigned long keyRepeatInterval;
+
     // Timer interrupt function to capture data - declared as public for use by AVR Timer1
     static void dscClockInterrupt();
 
   private:
 
-    void zoneLight(Light lightZone, byte zoneBit);
-    void panelLight(Light lightPanel, byte zoneBit);
+    // Panel commands queued for loop(), in order of priority
+    enum {commandAlarm, commandZoneQuery, commandZones, commandBlink, commandBeep, commandTone, commandBuzzer, commandStatus, commandCount};
+
+    void setLights();
+    void setLight(Light light, byte &lights, byte &lightsBlink, byte lightBit);
+    void queueCommand(byte command, byte deadline);
+    byte nextCommand();
+    void setPartitionCommands(byte partition);
+    void setStatusCommand(byte command);
+    void setZonesCommand(byte zoneGroup);
+    void setBlinkCommand(byte blinkGroup);
+    void setCommandByte(byte command[], byte commandByteTotal, byte commandByte, byte commandData);
+    void setPanelCommand(byte command[], byte commandByteTotal);
+    static void bufferKey(byte keyValue, byte partition);
 
     Stream* stream;
-    byte panelLights = 0x81, previousLights = 0x81;
-    byte panelBlink, previousBlink;
-    byte panelZones, previousZones;
-    byte panelZonesBlink, previousZonesBlink;
+    byte beepData, toneData, buzzerData;
+
+    // Panel command frames updated in place as lights change, including the checksum, and sent as-is by dscClockInterrupt()
+    byte panelCommand1C[1] = {0x1C};
+    byte statusCommands[(dscPartitions + 3) / 4][9];  // 0x05 partitions 1-4, 0x1B partitions 5-8
+    byte zonesCommands[dscZones][7];                   // 0x27, 0x2D, 0x34, 0x3E zones 1-32, 0xE6.09-0F zones 33-64
+    byte blinkCommands[(dscZones + 3) / 4][9];         // 0x5D zones 1-32, 0xE6.18 zones 33-64
+    byte pendingStatus, pendingZones, pendingBlink;  // Status commands, zone groups, and flashing lights commands to send, 1 bit each
+    byte statusCommand = 0x05;
     bool startupCycle = true;
-    bool setBeep, setTone, setBuzzer;
-    byte commandInterval = 5;   // Sets the milliseconds between panel commands
-    unsigned long intervalStart;
+    byte pendingCommands;                // Queued commands, 1 bit per command
+    unsigned long commandDeadline[commandCount];
+    byte commandInterval = 5;            // Sets the milliseconds between panel commands while idle
+    byte queuedCommandInterval = 2;      // Sets the milliseconds between panel commands while commands are queued, at least 2ms
 
     #if defined(ESP32)
     static hw_timer_t * timer1;
@@ -99,12 +133,17 @@ class dscKeypadInterface {
     static int clockInterval;
     static byte dscClockPin, dscReadPin, dscWritePin;
     static volatile byte keyData;
-    static volatile byte keyBufferLength;
-    static volatile byte keyBuffer[dscBufferSize];
+    static volatile byte keyBufferIndex, keyBufferLength;
+    static volatile byte keyBuffer[dscBufferSize], keyBufferPartition[dscBufferSize], keyBufferRepeat[dscBufferSize];
+    static volatile unsigned long keyBufferTime[dscBufferSize];
+    static volatile byte previousKey, previousKeyPartition, keyRepeatCount;
+    static volatile unsigned long previousKeyTime;
     static volatile bool commandReady, moduleDataDetected;
-    static volatile bool alarmKeyDetected, alarmKeyResponsePending;
+    static volatile unsigned long commandEndTime;  // micros() when dscClockInterrupt() completed the previous panel command
+    static volatile bool alarmKeyDetected;
     static volatile byte clockCycleCount, clockCycleTotal;
-    static volatile byte panelCommand[dscReadSize], panelCommandByteCount, panelCommandByteTotal;
+    static byte *panelCommand;
+    static volatile byte panelCommandByteCount, panelCommandByteTotal;
     static volatile byte isrPanelBitTotal, isrPanelBitCount;
     static volatile byte isrModuleData[dscReadSize], isrModuleBitTotal, isrModuleBitCount, isrModuleByteCount;
 };